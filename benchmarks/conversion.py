@@ -0,0 +1,170 @@
+# -*- coding: utf-8 -*-
+################################################################################
+# Copyright 2013-2014 Aerospike, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+################################################################################
+
+from __future__ import print_function
+
+import aerospike
+import sys
+import time
+
+from optparse import OptionParser
+
+################################################################################
+# Options Parsing
+################################################################################
+
+usage = "usage: %prog [options]"
+
+optparser = OptionParser(usage=usage, add_help_option=False)
+
+optparser.add_option(
+    "-h", "--host", dest="host", type="string", default="127.0.0.1", metavar="<ADDRESS>",
+    help="Address of Aerospike server.")
+
+optparser.add_option(
+    "-p", "--port", dest="port", type="int", default=3000, metavar="<PORT>",
+    help="Port of the Aerospike server.")
+
+optparser.add_option(
+    "-n", "--namespace", dest="namespace", type="string", default="test", metavar="<NS>",
+    help="Namespace to use.")
+
+optparser.add_option(
+    "-s", "--set", dest="set", type="string", default="demo", metavar="<SET>",
+    help="Set to use.")
+
+optparser.add_option(
+    "-e", "--elements", dest="elements", type="int", default=5000, metavar="<ELEMENTS>",
+    help="Number of elements of the list and map bins.")
+
+optparser.add_option(
+    "-c", "--count", dest="count", type="int", default=2000, metavar="<COUNT>",
+    help="Number of operations to measure for each record shape.")
+
+optparser.add_option(
+    "--get", dest="get", action="store_true",
+    help="Measure reading the records, instead of writing them.")
+
+optparser.add_option(
+    "--no-server", dest="no_server", action="store_true",
+    help="Measure only the conversion of the records, without a server.")
+
+optparser.add_option(
+    "--help", dest="help", action="store_true",
+    help="Displays this message.")
+
+(options, args) = optparser.parse_args()
+
+if options.help:
+    optparser.print_help()
+    print()
+    sys.exit(1)
+
+################################################################################
+# Client Configuration
+################################################################################
+
+config = {
+    'hosts': [ (options.host, options.port) ]
+}
+
+################################################################################
+# Application
+################################################################################
+
+n = options.elements
+
+groups = [
+    ("scalar", [
+        ("scalars", {'a': 1, 'b': 'xyz', 'c': 1.5}),
+    ]),
+    ("list-heavy", [
+        ("int list", {'l': list(range(n))}),
+        ("str list", {'l': ['value{0}'.format(i) for i in range(n)]}),
+        ("nested list", {'l': [[i, 'value', [i]] for i in range(n // 4)]}),
+    ]),
+    ("map-heavy", [
+        ("map", {'m': dict(('key{0}'.format(i), i) for i in range(n))}),
+        ("nested map", {'m': dict(('key{0}'.format(i), {'v': i, 'l': [i]}) for i in range(n // 4))}),
+    ]),
+]
+
+def measure(client, bins):
+    key = (options.namespace, options.set, 'conversion')
+    if options.no_server:
+        op = lambda key: client.convert(bins)
+    elif options.get:
+        client.put(key, bins)
+        op = client.get
+    else:
+        op = lambda key: client.put(key, bins)
+    start = time.time()
+    for i in range(options.count):
+        op(key)
+    return (time.time() - start) / options.count
+
+exitCode = 0
+
+try:
+
+    # ----------------------------------------------------------------------------
+    # Connect to Cluster, unless only the conversion is measured
+    # ----------------------------------------------------------------------------
+
+    client = aerospike.client(config)
+    if not options.no_server:
+        client.connect()
+
+    # ----------------------------------------------------------------------------
+    # Perform Operation
+    # ----------------------------------------------------------------------------
+
+    try:
+
+        op = "convert" if options.no_server else "get" if options.get else "put"
+
+        for (group, shapes) in groups:
+            print()
+            print(group)
+            print("{0:>12} {1:>16} {2:>12}".format("record", op + "s/sec", "usec/" + op))
+
+            for (name, bins) in shapes:
+                elapse = measure(client, bins)
+                print("{0:>12} {1:>16.1f} {2:>12.1f}".format(name, 1 / elapse, elapse * 1000000))
+
+        print()
+
+    except Exception as e:
+        print("error: {0}".format(e), file=sys.stderr)
+        exitCode = 2
+
+    # ----------------------------------------------------------------------------
+    # Close Connection to Cluster
+    # ----------------------------------------------------------------------------
+
+    if not options.no_server:
+        client.close()
+
+except Exception as e:
+    print("error: {0}".format(e), file=sys.stderr)
+    exitCode = 3
+
+################################################################################
+# Exit
+################################################################################
+
+sys.exit(exitCode)
@@ -0,0 +1,170 @@
+# -*- coding: utf-8 -*-
+################################################################################
+# Copyright 2013-2014 Aerospike, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+################################################################################
+
+from __future__ import print_function
+
+import aerospike
+import sys
+import time
+
+from optparse import OptionParser
+
+################################################################################
+# Options Parsing
+################################################################################
+
+usage = "usage: %prog [options]"
+
+optparser = OptionParser(usage=usage, add_help_option=False)
+
+optparser.add_option(
+    "-h", "--host", dest="host", type="string", default="127.0.0.1", metavar="<ADDRESS>",
+    help="Address of Aerospike server.")
+
+optparser.add_option(
+    "-p", "--port", dest="port", type="int", default=3000, metavar="<PORT>",
+    help="Port of the Aerospike server.")
+
+optparser.add_option(
+    "-n", "--namespace", dest="namespace", type="string", default="test", metavar="<NS>",
+    help="Namespace to use.")
+
+optparser.add_option(
+    "-s", "--set", dest="set", type="string", default="scanbench", metavar="<SET>",
+    help="Set to use.")
+
+optparser.add_option(
+    "-k", "--keys", dest="keys", type="int", default=100000, metavar="<KEYS>",
+    help="Number of records to write and scan.")
+
+optparser.add_option(
+    "-b", "--bins", dest="bins", type="int", default=20, metavar="<BINS>",
+    help="Number of bins of each record.")
+
+optparser.add_option(
+    "-r", "--rounds", dest="rounds", type="int", default=5, metavar="<ROUNDS>",
+    help="Number of scans to measure.")
+
+optparser.add_option(
+    "--schema", dest="schema", action="store_true",
+    help="Scan through a schema of the bins, reading rows instead of dicts.")
+
+optparser.add_option(
+    "--skip-load", dest="skip_load", action="store_true",
+    help="Scan the records written by a previous run.")
+
+optparser.add_option(
+    "--help", dest="help", action="store_true",
+    help="Displays this message.")
+
+(options, args) = optparser.parse_args()
+
+if options.help:
+    optparser.print_help()
+    print()
+    sys.exit(1)
+
+################################################################################
+# Client Configuration
+################################################################################
+
+config = {
+    'hosts': [ (options.host, options.port) ]
+}
+
+################################################################################
+# Application
+################################################################################
+
+bins = ['bin{0}'.format(b) for b in range(options.bins)]
+
+def load(client):
+    for i in range(options.keys):
+        client.put((options.namespace, options.set, i), dict((name, i) for name in bins))
+
+def measure(client):
+    best = None
+    names = set()
+    for r in range(options.rounds):
+        start = time.time()
+        results = client.scan(options.namespace, options.set).results()
+        elapse = time.time() - start
+        best = elapse if best is None else min(best, elapse)
+        # Distinct bin name objects in the results. One per bin name, when the
+        # names are shared by the records.
+        names = set(id(name) for (key, meta, rec) in results for name in rec)
+        del results
+    return (best, len(names))
+
+def measure_schema(client):
+    schema = client.schema(options.namespace, options.set, [(name, int) for name in bins])
+    best = None
+    for r in range(options.rounds):
+        start = time.time()
+        results = schema.results()
+        elapse = time.time() - start
+        best = elapse if best is None else min(best, elapse)
+        del results
+    # Rows hold no bin name objects
+    return (best, 0)
+
+exitCode = 0
+
+try:
+
+    # ----------------------------------------------------------------------------
+    # Connect to Cluster
+    # ----------------------------------------------------------------------------
+
+    client = aerospike.client(config).connect()
+
+    # ----------------------------------------------------------------------------
+    # Perform Operation
+    # ----------------------------------------------------------------------------
+
+    try:
+
+        if not options.skip_load:
+            load(client)
+
+        (elapse, names) = measure_schema(client) if options.schema else measure(client)
+        records = options.keys / elapse
+
+        print()
+        print("{0:>16} {1:>16} {2:>16}".format("records/sec", "bins/sec", "name objects"))
+        print("{0:>16.1f} {1:>16.1f} {2:>16}".format(records, records * options.bins, names))
+        print()
+
+    except Exception as e:
+        print("error: {0}".format(e), file=sys.stderr)
+        exitCode = 2
+
+    # ----------------------------------------------------------------------------
+    # Close Connection to Cluster
+    # ----------------------------------------------------------------------------
+
+    client.close()
+
+except Exception as e:
+    print("error: {0}".format(e), file=sys.stderr)
+    exitCode = 3
+
+################################################################################
+# Exit
+################################################################################
+
+sys.exit(exitCode)
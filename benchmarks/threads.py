@@ -0,0 +1,161 @@
+# -*- coding: utf-8 -*-
+################################################################################
+# Copyright 2013-2014 Aerospike, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+################################################################################
+
+from __future__ import print_function
+
+import aerospike
+import random
+import sys
+import threading
+import time
+
+from optparse import OptionParser
+
+################################################################################
+# Options Parsing
+################################################################################
+
+usage = "usage: %prog [options]"
+
+optparser = OptionParser(usage=usage, add_help_option=False)
+
+optparser.add_option(
+    "-h", "--host", dest="host", type="string", default="127.0.0.1", metavar="<ADDRESS>",
+    help="Address of Aerospike server.")
+
+optparser.add_option(
+    "-p", "--port", dest="port", type="int", default=3000, metavar="<PORT>",
+    help="Port of the Aerospike server.")
+
+optparser.add_option(
+    "-n", "--namespace", dest="namespace", type="string", default="test", metavar="<NS>",
+    help="Namespace to use.")
+
+optparser.add_option(
+    "-s", "--set", dest="set", type="string", default="demo", metavar="<SET>",
+    help="Set to use.")
+
+optparser.add_option(
+    "-k", "--keys", dest="keys", type="int", default=10000, metavar="<KEYS>",
+    help="Number of distinct keys to read and write.")
+
+optparser.add_option(
+    "-t", "--threads", dest="threads", type="string", default="1,2,4,8,16", metavar="<LIST>",
+    help="Comma separated list of thread counts to measure.")
+
+optparser.add_option(
+    "-d", "--duration", dest="duration", type="float", default=5.0, metavar="<SECONDS>",
+    help="Number of seconds to run each thread count.")
+
+optparser.add_option(
+    "--help", dest="help", action="store_true",
+    help="Displays this message.")
+
+(options, args) = optparser.parse_args()
+
+if options.help:
+    optparser.print_help()
+    print()
+    sys.exit(1)
+
+################################################################################
+# Client Configuration
+################################################################################
+
+config = {
+    'hosts': [ (options.host, options.port) ]
+}
+
+################################################################################
+# Application
+################################################################################
+
+def worker(client, stop, counts, index):
+    count = 0
+    while not stop.is_set():
+        key = (options.namespace, options.set, random.randrange(0, options.keys))
+        if count % 5 == 0:
+            client.put(key, {'key': key[2]})
+        else:
+            client.get(key)
+        count += 1
+    counts[index] = count
+
+def measure(client, nthreads):
+    stop = threading.Event()
+    counts = [0] * nthreads
+    threads = [threading.Thread(target=worker, args=(client, stop, counts, i)) for i in range(nthreads)]
+    start = time.time()
+    for t in threads:
+        t.start()
+    time.sleep(options.duration)
+    stop.set()
+    for t in threads:
+        t.join()
+    elapse = time.time() - start
+    return sum(counts) / elapse
+
+exitCode = 0
+
+try:
+
+    # ----------------------------------------------------------------------------
+    # Connect to Cluster
+    # ----------------------------------------------------------------------------
+
+    client = aerospike.client(config).connect()
+
+    # ----------------------------------------------------------------------------
+    # Perform Operation
+    # ----------------------------------------------------------------------------
+
+    try:
+
+        for i in range(options.keys):
+            client.put((options.namespace, options.set, i), {'key': i})
+
+        print()
+        print("{0:>8} {1:>16} {2:>10}".format("threads", "ops/sec", "scaling"))
+
+        base = None
+        for nthreads in [int(n) for n in options.threads.split(',')]:
+            tps = measure(client, nthreads)
+            if base is None:
+                base = tps / nthreads
+            print("{0:>8} {1:>16.1f} {2:>10.2f}".format(nthreads, tps, tps / base))
+
+        print()
+
+    except Exception as e:
+        print("error: {0}".format(e), file=sys.stderr)
+        exitCode = 2
+
+    # ----------------------------------------------------------------------------
+    # Close Connection to Cluster
+    # ----------------------------------------------------------------------------
+
+    client.close()
+
+except Exception as e:
+    print("error: {0}".format(e), file=sys.stderr)
+    exitCode = 3
+
+################################################################################
+# Exit
+################################################################################
+
+sys.exit(exitCode)
@@ -60,7 +60,8 @@ libraries = [
   'ssl',
   'crypto',
   'pthread',
-  'm'
+  'm',
+  'z'
   ]
 
 ################################################################################
@@ -281,22 +282,33 @@ setup(
             'src/main/aerospike.c', 
             'src/main/client/type.c',
             'src/main/client/apply.c',
+            'src/main/client/async.c',
             'src/main/client/close.c',
             'src/main/client/connect.c',
+            'src/main/client/convert.c',
+            'src/main/client/digest.c',
             'src/main/client/exists.c',
+            'src/main/client/exists_many.c',
             'src/main/client/get.c',
+            'src/main/client/get_many.c',
             'src/main/client/info.c',
+            'src/main/client/operate.c',
             'src/main/client/key.c',
             'src/main/client/put.c',
+            'src/main/client/put_many.c',
             'src/main/client/query.c',
             'src/main/client/remove.c',
             'src/main/client/scan.c',
+            'src/main/client/schema.c',
+            'src/main/client/select.c',
+            'src/main/client/get_json.c',
             'src/main/key/type.c',
             'src/main/key/apply.c',
             'src/main/key/exists.c',
             'src/main/key/get.c',
             'src/main/key/put.c',
             'src/main/key/remove.c',
+            'src/main/key/select.c',
             'src/main/query/type.c',
             'src/main/query/apply.c',
             'src/main/query/foreach.c',
@@ -307,8 +319,27 @@ setup(
             'src/main/scan/foreach.c',
             'src/main/scan/results.c',
             'src/main/scan/select.c',
+            'src/main/schema/type.c',
+            'src/main/schema/get.c',
+            'src/main/schema/put.c',
+            'src/main/schema/row.c',
+            'src/main/schema/scan.c',
+            'src/main/bytes_view/type.c',
+            'src/main/cancel/type.c',
+            'src/main/record/type.c',
+            'src/main/stream/type.c',
+            'src/main/future/type.c',
+            'src/main/future/result.c',
+            'src/main/async.c',
+            'src/main/arena.c',
             'src/main/conversions.c',
+            'src/main/intern.c',
             'src/main/policy.c',
+            'src/main/packer.c',
+            'src/main/compression.c',
+            'src/main/serializer.c',
+            'src/main/results.c',
+            'src/main/json.c',
             'src/main/predicates.c'
         ],
 
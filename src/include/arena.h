@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/**
+ * The size of the first block, held within the arena itself, which covers
+ * the values of a typical record without allocating.
+ */
+#define ARENA_INLINE_SIZE 1024
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+typedef struct arena_block_s arena_block;
+
+typedef struct arena_cleanup_s arena_cleanup;
+
+/**
+ * Releases a resource which values of the arena point into.
+ */
+typedef void (* arena_cleanup_fn)(void * data);
+
+/**
+ * A bump allocator for the values built while converting a request. The
+ * memory is released all at once by arena_destroy(), so values allocated
+ * from an arena must be initialized with free=false, and destroyed before
+ * the arena.
+ *
+ * The arena points into itself, so it must not be copied once initialized.
+ */
+typedef struct {
+	uint8_t * pos;
+	uint8_t * end;
+	arena_block * blocks;
+	arena_cleanup * cleanups;
+	union {
+		uint8_t data[ARENA_INLINE_SIZE];
+		long double align;
+	} inline_block;
+} arena;
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+void arena_init(arena * a);
+
+/**
+ * Allocates `size` bytes, aligned for any value.
+ */
+void * arena_alloc(arena * a, size_t size);
+
+/**
+ * Registers a function to call with the data when the arena is destroyed.
+ * Returns false if it could not be registered.
+ */
+bool arena_defer(arena * a, arena_cleanup_fn fn, void * data);
+
+/**
+ * Runs the cleanups of the arena, most recent first, and releases its memory.
+ */
+void arena_destroy(arena * a);
@@ -0,0 +1,143 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <aerospike/aerospike.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_key.h>
+#include <aerospike/as_list.h>
+#include <aerospike/as_policy.h>
+#include <aerospike/as_record.h>
+#include <aerospike/as_val.h>
+
+#include "arena.h"
+#include "compression.h"
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+typedef enum {
+	ASYNC_OP_GET,
+	ASYNC_OP_PUT,
+	ASYNC_OP_EXISTS,
+	ASYNC_OP_REMOVE,
+	ASYNC_OP_APPLY
+} async_op;
+
+/**
+ * An operation executed by the engine. The arguments are converted by the
+ * submitter, the engine executes the operation and populates the result and
+ * the error, then hands the job back through async_engine_completed().
+ *
+ * The engine never touches `udata`, which is reserved for the submitter.
+ */
+typedef struct async_job_s {
+	struct async_job_s * next;
+	async_op op;
+
+	// Arguments
+	as_key key;
+	as_record rec;
+	bool rec_initialized;
+	const char * module;
+	const char * function;
+	as_list * arglist;
+	arena arena;
+	compression compression;
+	union {
+		as_policy_read read;
+		as_policy_write write;
+		as_policy_remove remove;
+		as_policy_apply apply;
+	} policy;
+	void * policy_p;
+
+	// Results
+	as_error err;
+	as_record * result_rec;
+	as_val * result_val;
+
+	void * udata;
+} async_job;
+
+typedef struct async_engine_s async_engine;
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * Allocates a zeroed job for the given operation.
+ */
+async_job * async_job_new(async_op op);
+
+/**
+ * Releases the arguments and results of the job, and the job itself.
+ */
+void async_job_destroy(async_job * job);
+
+/**
+ * Starts an engine with `nthreads` worker threads executing jobs against
+ * the given cluster, queueing at most `max_pending` jobs not yet executing
+ * (0 for no limit). Returns NULL if the engine could not be started.
+ */
+async_engine * async_engine_new(aerospike * as, uint32_t nthreads, uint32_t max_pending);
+
+/**
+ * Queues a job for execution. Returns false, leaving the job to the caller,
+ * if the queue is full.
+ */
+bool async_engine_submit(async_engine * engine, async_job * job);
+
+/**
+ * The file descriptor which becomes readable when jobs have completed.
+ */
+int async_engine_fd(async_engine * engine);
+
+/**
+ * Blocks until the file descriptor is readable, or the timeout (in
+ * milliseconds, negative for none) expires.
+ */
+void async_engine_wait(async_engine * engine, int timeout_ms);
+
+/**
+ * Clears the file descriptor and returns the list of completed jobs,
+ * linked by `next`, or NULL if no jobs have completed.
+ */
+async_job * async_engine_completed(async_engine * engine);
+
+/**
+ * Takes a reference to the engine, keeping its memory and file descriptor
+ * valid until the matching async_engine_release().
+ */
+void async_engine_retain(async_engine * engine);
+
+/**
+ * Drops a reference to the engine, releasing it with the last one.
+ */
+void async_engine_release(async_engine * engine);
+
+/**
+ * Waits for the queued jobs to execute, stops the worker threads, wakes the
+ * waiters and drops the reference of the owner. Returns the completed jobs
+ * not yet collected.
+ */
+async_job * async_engine_destroy(async_engine * engine);
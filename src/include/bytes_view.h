@@ -0,0 +1,47 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "types.h"
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+PyTypeObject * AerospikeBytesView_Ready(void);
+
+/**
+ * Creates a read-only view of `size` bytes at `data`. The view holds a
+ * reference to `owner`, which must keep the memory alive.
+ */
+PyObject * AerospikeBytesView_New(PyObject * owner, const uint8_t * data, Py_ssize_t size);
+
+/*******************************************************************************
+ * OPERATIONS
+ ******************************************************************************/
+
+/**
+ * Copies the bytes of the view into a new string.
+ *
+ *		view.tobytes()
+ *
+ */
+PyObject * AerospikeBytesView_ToBytes(AerospikeBytesView * self, PyObject * args, PyObject * kwds);
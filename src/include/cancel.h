@@ -0,0 +1,63 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include <aerospike/as_error.h>
+
+#include "types.h"
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+PyTypeObject * AerospikeCancelToken_Ready(void);
+
+/**
+ * Whether the token was cancelled. A NULL token is never cancelled. Does not
+ * require the GIL, so the node threads of a scan or query may check it.
+ */
+bool AerospikeCancelToken_Cancelled(const AerospikeCancelToken * self);
+
+/**
+ * Converts the optional 'cancel' argument of a scan or query. Sets *cancel to
+ * a borrowed reference, or NULL for None.
+ */
+as_status pyobject_to_cancel_token(as_error * err, PyObject * py_cancel, AerospikeCancelToken ** cancel);
+
+/*******************************************************************************
+ * OPERATIONS
+ ******************************************************************************/
+
+/**
+ * Cancels the scans and queries which were given the token. They stop at the
+ * next result each node returns. Safe to call from any thread.
+ *
+ *		token.cancel()
+ *
+ */
+PyObject * AerospikeCancelToken_Cancel(AerospikeCancelToken * self, PyObject * args, PyObject * kwds);
+
+/**
+ * Whether the token was cancelled.
+ *
+ *		token.cancelled()
+ *
+ */
+PyObject * AerospikeCancelToken_Is_Cancelled(AerospikeCancelToken * self, PyObject * args, PyObject * kwds);
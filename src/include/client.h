@@ -77,6 +77,25 @@ PyObject * AerospikeClient_Exists(AerospikeClient * self, PyObject * args, PyObj
  */
 PyObject * AerospikeClient_Get(AerospikeClient * self, PyObject * args, PyObject * kwds);
 
+/**
+ * Read specific bins of a record from the database.
+ *
+ *		client.select((x,y,z), ["a","b","c"])
+ *
+ */
+PyObject * AerospikeClient_Select(AerospikeClient * self, PyObject * args, PyObject * kwds);
+
+/**
+ * Read a record from the database, and return its bins as a UTF-8 JSON 
+ * string, encoded from the record without creating Python values. Returns 
+ * None if the record does not exist. Optionally, only the specified bins are
+ * read.
+ *
+ *		client.get_json((x,y,z), ["a","b","c"])
+ *
+ */
+PyObject * AerospikeClient_Get_Json(AerospikeClient * self, PyObject * args, PyObject * kwds);
+
 /**
  * Write a record in the database.
  *
@@ -85,6 +104,15 @@ PyObject * AerospikeClient_Get(AerospikeClient * self, PyObject * args, PyObject
  */
 PyObject * AerospikeClient_Put(AerospikeClient * self, PyObject * args, PyObject * kwds);
 
+/**
+ * Perform multiple operations on a single record in the database, in a
+ * single transaction.
+ *
+ *		client.operate((x,y,z), [{'op': aerospike.OPERATOR_INCR, 'bin': 'count', 'val': 1}, ...])
+ *
+ */
+PyObject * AerospikeClient_Operate(AerospikeClient * self, PyObject * args, PyObject * kwds);
+
 /**
  * Remove a record from the database.
  *
@@ -94,6 +122,99 @@ PyObject * AerospikeClient_Put(AerospikeClient * self, PyObject * args, PyObject
 PyObject * AerospikeClient_Remove(AerospikeClient * self, PyObject * args, PyObject * kwds);
 
 
+/*******************************************************************************
+ * BATCH OPERATIONS
+ ******************************************************************************/
+
+/**
+ * Read multiple records from the database, using one batch request per node.
+ * Returns a dict mapping each of the given keys to a (key, meta, bins) 
+ * tuple. Optionally, only the specified bins are read.
+ *
+ *		client.get_many([(x,y,z), ...], bins)
+ *
+ */
+PyObject * AerospikeClient_Get_Many(AerospikeClient * self, PyObject * args, PyObject * kwds);
+
+/**
+ * Check the existence of multiple records in the database, using one batch
+ * request per node. Returns a dict mapping each of the given keys to a 
+ * (key, meta) tuple, or None if the record does not exist.
+ *
+ *		client.exists_many([(x,y,z), ...])
+ *
+ */
+PyObject * AerospikeClient_Exists_Many(AerospikeClient * self, PyObject * args, PyObject * kwds);
+
+/**
+ * Write the (key, bins) or (key, bins, meta) items of an iterable into the
+ * database. Items are converted on the calling thread, and written by a pool
+ * of `concurrency` native threads, with at most `max_inflight` items 
+ * converted but not yet written. Returns a list of (key, error) tuples for 
+ * the items which failed.
+ *
+ *		client.put_many(items, concurrency=16)
+ *
+ */
+PyObject * AerospikeClient_Put_Many(AerospikeClient * self, PyObject * args, PyObject * kwds);
+
+
+/*******************************************************************************
+ * ASYNC OPERATIONS
+ ******************************************************************************/
+
+/**
+ * The async variants of the KVS operations return an aerospike.Future right
+ * away. The operations are executed by a pool of native threads, and signal 
+ * their completion through a file descriptor. An event loop watches the file
+ * descriptor returned by `async_fd()`, and calls `async_poll()` when it is
+ * readable, to complete the futures of the finished operations:
+ *
+ *		loop.add_reader(client.async_fd(), client.async_poll)
+ *		future = client.get_async((x,y,z))
+ *		future.add_done_callback(on_done)
+ *
+ * A coroutine can also wait for a future without an event loop reader, by
+ * iterating it, which completes the finished operations at each step:
+ *
+ *		result = yield from client.get_async((x,y,z))
+ *
+ * The C client has no event loop API, so the operations run on a pool of
+ * 'async_threads' native threads (config, default 16), which bounds the
+ * operations in flight. At most 'async_max_pending' more operations (config,
+ * default 4096, 0 for no limit) wait for a thread; beyond that the
+ * submission raises.
+ *
+ */
+PyObject * AerospikeClient_Get_Async(AerospikeClient * self, PyObject * args, PyObject * kwds);
+
+PyObject * AerospikeClient_Put_Async(AerospikeClient * self, PyObject * args, PyObject * kwds);
+
+PyObject * AerospikeClient_Exists_Async(AerospikeClient * self, PyObject * args, PyObject * kwds);
+
+PyObject * AerospikeClient_Remove_Async(AerospikeClient * self, PyObject * args, PyObject * kwds);
+
+PyObject * AerospikeClient_Apply_Async(AerospikeClient * self, PyObject * args, PyObject * kwds);
+
+/**
+ * Returns the file descriptor which becomes readable when async operations
+ * have completed.
+ *
+ *		client.async_fd()
+ *
+ */
+PyObject * AerospikeClient_Async_Fd(AerospikeClient * self, PyObject * args, PyObject * kwds);
+
+/**
+ * Completes the futures of the async operations which have finished, and
+ * returns the number of futures completed.
+ *
+ *		client.async_poll()
+ *
+ */
+PyObject * AerospikeClient_Async_Poll(AerospikeClient * self, PyObject * args, PyObject * kwds);
+
+
 /*******************************************************************************
  * INTENRAL (SHARED) OPERATIONS, FOR COMPATIBILITY W/ OLD API
  ******************************************************************************/
@@ -111,6 +232,10 @@ PyObject * AerospikeClient_Get_Invoke(
 	AerospikeClient * self, 
 	PyObject * py_key, PyObject * py_policy);
 
+PyObject * AerospikeClient_Select_Invoke(
+	AerospikeClient * self, 
+	PyObject * py_key, PyObject * py_bins, PyObject * py_policy);
+
 PyObject * AerospikeClient_Put_Invoke(
 	AerospikeClient * self, 
 	PyObject * py_key, PyObject * py_bins, PyObject * py_meta, PyObject * py_policy);
@@ -119,6 +244,18 @@ PyObject * AerospikeClient_Remove_Invoke(
 	AerospikeClient * self, 
 	PyObject * py_key, PyObject * py_policy);
 
+/**
+ * Completes the futures of the finished async operations. Returns the number
+ * of futures completed.
+ */
+int AerospikeClient_Async_Process(AerospikeClient * self);
+
+/**
+ * Waits for the queued async operations, completes their futures and stops
+ * the async engine.
+ */
+void AerospikeClient_Async_Close(AerospikeClient * self);
+
 
 /*******************************************************************************
  * KEY OPERATIONS (DEPRECATED)
@@ -140,6 +277,26 @@ PyObject * AerospikeClient_Remove_Invoke(
  */
 AerospikeKey * AerospikeClient_Key(AerospikeClient * self, PyObject * args, PyObject * kwds);
 
+/**
+ * Compute the digest of a key, which can address the record in place of the
+ * key, without hashing the key again. The digest is a str, so it can also be
+ * used as a dict key:
+ *
+ *		digest = client.digest(ns,set,key)
+ *		rec = client.get((ns,set,None,digest))
+ *
+ */
+PyObject * AerospikeClient_Digest(AerospikeClient * self, PyObject * args, PyObject * kwds);
+
+/**
+ * Convert a record the way put() does, without sending it, to validate the
+ * record or measure the conversion. Does not need a connection.
+ *
+ *		client.convert({"a": 123, "b": "xyz"})
+ *
+ */
+PyObject * AerospikeClient_Convert(AerospikeClient * self, PyObject * args, PyObject * kwds);
+
 /*******************************************************************************
  * SCAN OPERATIONS
  ******************************************************************************/
@@ -162,9 +319,37 @@ AerospikeKey * AerospikeClient_Key(AerospikeClient * self, PyObject * args, PyOb
  *		for record in client.scan(ns,set).results():
  *			print record
  *
+ * The optional options dict sets the 'priority' of the scan on the server,
+ * one of the aerospike.SCAN_PRIORITY_* constants, the 'percent' of records
+ * to sample, from 1 to 100, 'nobins' to read the keys and metadata only, and
+ * 'concurrent' to scan the nodes in parallel:
+ *
+ *		client.scan(ns,set,{'priority': aerospike.SCAN_PRIORITY_LOW, 'percent': 10})
+ *
  */
 AerospikeScan * AerospikeClient_Scan(AerospikeClient * self, PyObject * args, PyObject * kwds);
 
+/*******************************************************************************
+ * SCHEMA OPERATIONS
+ ******************************************************************************/
+
+/**
+ * Creates a schema for a set whose records have a fixed list of bins. Each
+ * bin is a name, or a (name, type) tuple. The schema reads records as rows,
+ * with an attribute for each bin, and writes records from tuples of values
+ * in the order of the bins:
+ *
+ *		users = client.schema(ns, set, [('name', str), ('age', int)])
+ *		users.put(key, ('bob', 42))
+ *		row = users.get(key)
+ *		print row.name, row.age
+ *
+ *		for row in users.results():
+ *			print row
+ *
+ */
+AerospikeSchema * AerospikeClient_Schema(AerospikeClient * self, PyObject * args, PyObject * kwds);
+
 /*******************************************************************************
  * QUERY OPERATIONS
  ******************************************************************************/
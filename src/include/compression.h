@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <aerospike/as_bytes.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_record.h>
+#include <aerospike/as_val.h>
+
+#include "arena.h"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/**
+ * A compressed bin is a bytes bin, which starts with a header of the magic
+ * bytes, the as_val type and the bytes type of the original value, and the
+ * size of the original value, in big endian. Bytes without the header, or
+ * which fail to inflate, are read as they are.
+ *
+ * Bins are only inflated on read by clients configured with 'decompress',
+ * which defaults to on when the client has a 'compress_threshold'. Clients
+ * reading bins compressed by a write policy set it explicitly.
+ */
+#define COMPRESSION_MAGIC "\x89" "ASZ"
+#define COMPRESSION_MAGIC_SIZE 4
+#define COMPRESSION_HEADER_SIZE 10
+
+/**
+ * zlib inflates at most 1032 bytes per compressed byte, so headers claiming a
+ * larger size are not trusted with an allocation.
+ */
+#define COMPRESSION_RATIO_MAX 1032
+
+/**
+ * The zlib default level, a trade of speed for size.
+ */
+#define COMPRESSION_LEVEL_DEFAULT (-1)
+#define COMPRESSION_LEVEL_MAX 9
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+/**
+ * The compression of the string and bytes bins of written records. Bins of
+ * at least `threshold` bytes are compressed with zlib at `level`, when that
+ * makes them smaller. A threshold of 0 disables compression.
+ */
+typedef struct {
+	uint32_t threshold;
+	int level;
+} compression;
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * Compresses the bins of a record in place. The compressed values are
+ * allocated from the arena of the record's values. Does not require the GIL.
+ */
+as_status compression_compress_record(as_error * err, const compression * c, as_record * rec, arena * arena);
+
+/**
+ * Whether the bytes carry a valid compression header, a check cheap enough to
+ * make before deciding how to inflate them.
+ */
+bool compression_is_compressed(const as_bytes * bytes);
+
+/**
+ * Inflates a compressed bin into a heap buffer, which the caller frees.
+ * Returns false when the bytes are not a compressed value. Does not require
+ * the GIL.
+ */
+bool compression_inflate(const as_bytes * bytes, as_val_t * val_type, as_bytes_type * bytes_type, uint8_t ** data, uint32_t * size);
@@ -19,36 +19,104 @@
 #include <Python.h>
 #include <stdbool.h>
 
+#include <aerospike/as_batch.h>
 #include <aerospike/as_key.h>
 #include <aerospike/as_error.h>
+#include <aerospike/as_operations.h>
 #include <aerospike/as_record.h>
 
+#include "arena.h"
 #include "key.h"
 
 as_status pykey_to_key(as_error * err, AerospikeKey * py_key, as_key * key);
 
-as_status pyobject_to_val(as_error * err, PyObject * py_obj, as_val ** val);
+typedef as_status (* pyobject_to_val_fn)(AerospikeClient * self, as_error * err, PyObject * py_obj, as_val ** val, arena * arena);
 
-as_status pyobject_to_map(as_error * err, PyObject * py_dict, as_map ** map);
+/**
+ * Returns the converter for values of exactly the given type, or NULL if the
+ * type is not supported. Unlike pyobject_to_val(), the converters do not
+ * handle None or subclasses.
+ */
+pyobject_to_val_fn pyobject_to_val_converter(PyTypeObject * type);
 
-as_status pyobject_to_list(as_error * err, PyObject * py_list, as_list ** list);
+/**
+ * Converts a PyObject into an as_val. When an arena is given, the values are
+ * allocated from it, so they must be destroyed before the arena. Otherwise,
+ * they are allocated from the heap. Values of unsupported types are converted
+ * with the serializer of the client, if it has one.
+ */
+as_status pyobject_to_val(AerospikeClient * self, as_error * err, PyObject * py_obj, as_val ** val, arena * arena);
+
+as_status pyobject_to_map(AerospikeClient * self, as_error * err, PyObject * py_dict, as_map ** map, arena * arena);
+
+as_status pyobject_to_list(AerospikeClient * self, as_error * err, PyObject * py_list, as_list ** list, arena * arena);
 
 as_status pyobject_to_key(as_error * err, PyObject * py_key, as_key * key);
 
-as_status pyobject_to_record(as_error * err, PyObject * py_rec, PyObject * py_meta, as_record * rec);
+as_status pyobject_to_batch(as_error * err, PyObject * py_keys, as_batch * batch);
+
+as_status pyobject_to_record(AerospikeClient * self, as_error * err, PyObject * py_rec, PyObject * py_meta, as_record * rec, arena * arena);
+
+as_status pyobject_to_metadata(as_error * err, PyObject * py_meta, as_record * rec);
+
+/**
+ * Converts a list or tuple of bin names into a NULL-terminated array of
+ * names. The names are borrowed from the sequence returned through py_seq,
+ * which must be kept alive while they are in use. The caller frees the
+ * array and releases the sequence, even on error.
+ */
+as_status pyobject_to_bin_names(as_error * err, PyObject * py_bins, PyObject ** py_seq, const char *** bins, uint32_t * n_bins);
+
+as_status pyobject_to_operations(AerospikeClient * self, as_error * err, PyObject * py_ops, PyObject * py_meta, as_operations * ops, arena * arena);
 
 as_status val_to_pyobject(as_error * err, const as_val * val, PyObject ** py_map);
 
+/**
+ * Converts a value. When an owner is given, bytes are returned as views of
+ * the value's memory, which the owner keeps alive, rather than as copies.
+ * When a client is given, serialized bytes are converted with its
+ * deserializer.
+ */
+as_status val_to_pyobject_owned(AerospikeClient * self, as_error * err, const as_val * val, PyObject * owner, PyObject ** py_val);
+
 as_status map_to_pyobject(as_error * err, const as_map * map, PyObject ** py_map);
 
 as_status list_to_pyobject(as_error * err, const as_list * list, PyObject ** py_list);
 
-as_status record_to_pyobject(as_error * err, const as_record * rec, const as_key * key, PyObject ** obj);
+/**
+ * Converts a record to a (key, meta, bins) tuple. When a client is given,
+ * the bin names are taken from its table of bin name strings. The key is
+ * converted by result_key_to_pyobject().
+ */
+as_status record_to_pyobject(AerospikeClient * self, as_error * err, const as_record * rec, const as_key * key, PyObject * py_key, PyObject ** obj);
+
+/**
+ * Converts a record, returning bytes bins as read-only aerospike.BytesView
+ * objects over the record's memory instead of copies. Takes ownership of the
+ * record, which is destroyed when the last view is released, and sets *rec
+ * to NULL.
+ */
+as_status record_to_pyobject_view(AerospikeClient * self, as_error * err, as_record ** rec, const as_key * key, PyObject * py_key, PyObject ** obj);
+
+/**
+ * Wraps a heap allocated record in a capsule, which destroys the record
+ * when released.
+ */
+PyObject * record_to_capsule(as_record * rec);
 
 as_status key_to_pyobject(as_error * err, const as_key * key, PyObject ** obj);
 
+/**
+ * Converts the key of a result. For single-key calls, py_key is the key
+ * object the caller passed, which is returned as is when the client is
+ * configured with 'reuse_keys', rather than a key rebuilt from the as_key.
+ * A reused key carries no digest, so the option is off by default. Scan,
+ * query and batch results pass NULL, to build the key.
+ */
+as_status result_key_to_pyobject(AerospikeClient * self, as_error * err, const as_key * key, PyObject * py_key, PyObject ** obj);
+
 as_status metadata_to_pyobject(as_error * err, const as_record * rec, PyObject ** obj);
 
-as_status bins_to_pyobject(as_error * err, const as_record * rec, PyObject ** obj);
+as_status bins_to_pyobject(AerospikeClient * self, as_error * err, const as_record * rec, PyObject ** obj);
 
 bool error_to_pyobject(const as_error * err, PyObject ** obj);
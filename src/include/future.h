@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include "types.h"
+#include "client.h"
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+PyTypeObject * AerospikeFuture_Ready(void);
+
+AerospikeFuture * AerospikeFuture_New(AerospikeClient * client);
+
+/**
+ * Completes the future with either a result or an error tuple, and invokes
+ * the done callbacks. Steals the references to py_result and py_err.
+ */
+void AerospikeFuture_Complete(AerospikeFuture * self, PyObject * py_result, PyObject * py_err);
+
+/*******************************************************************************
+ * OPERATIONS
+ ******************************************************************************/
+
+/**
+ * Whether the operation has completed.
+ *
+ *		future.done()
+ *
+ */
+PyObject * AerospikeFuture_Done(AerospikeFuture * self, PyObject * args, PyObject * kwds);
+
+/**
+ * Returns the result of the operation, or raises its error. If the operation
+ * is still in progress, waits up to `timeout` seconds (forever by default),
+ * completing any other operations of the client which finish meanwhile.
+ *
+ *		future.result()
+ *
+ */
+PyObject * AerospikeFuture_Result(AerospikeFuture * self, PyObject * args, PyObject * kwds);
+
+/**
+ * Returns the error tuple of the operation, or None if it succeeded.
+ *
+ *		future.exception()
+ *
+ */
+PyObject * AerospikeFuture_Exception(AerospikeFuture * self, PyObject * args, PyObject * kwds);
+
+/**
+ * Adds a callback, invoked with the future once the operation completes.
+ * If the operation already completed, the callback is invoked immediately.
+ *
+ *		future.add_done_callback(fn)
+ *
+ */
+PyObject * AerospikeFuture_Add_Done_Callback(AerospikeFuture * self, PyObject * args, PyObject * kwds);
@@ -0,0 +1,48 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <stdint.h>
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+/**
+ * A table of Python strings for bin names, so the results of a client share
+ * a single string object, with a cached hash, for each bin name.
+ */
+typedef struct intern_table_s intern_table;
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+intern_table * intern_table_new(void);
+
+/**
+ * Releases the strings of the table, and the table itself. Requires the GIL.
+ */
+void intern_table_destroy(intern_table * table);
+
+/**
+ * Returns a new reference to the string for the name, creating it on first
+ * use. Once the table is full, new names are returned as fresh strings.
+ * Requires the GIL.
+ */
+PyObject * intern_table_get(intern_table * table, const char * name);
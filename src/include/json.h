@@ -0,0 +1,46 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <aerospike/as_error.h>
+#include <aerospike/as_record.h>
+
+/*******************************************************************************
+ * FUNCTIONS
+ *
+ * The JSON is UTF-8, with non-ASCII characters as they are. Bytes are encoded
+ * as base64 strings, compressed bins as the value they were compressed from,
+ * and non-finite floats as null. Map keys which are not strings are encoded
+ * as json.dumps() would. The JSON is returned in a heap buffer, which the
+ * caller frees.
+ ******************************************************************************/
+
+/**
+ * Encodes the bins of a record as a JSON object, inflating compressed bins
+ * when `decompress` is set. Does not require the GIL.
+ */
+as_status json_encode_record(as_error * err, const as_record * rec, bool decompress, char ** data, size_t * size);
+
+/**
+ * Encodes a Python value, such as the bins of a record which were already
+ * converted. Requires the GIL.
+ */
+as_status json_encode_pyobject(as_error * err, PyObject * py_obj, char ** data, size_t * size);
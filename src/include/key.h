@@ -66,9 +66,10 @@ PyObject * AerospikeKey_Get(AerospikeKey * self, PyObject * args, PyObject * kwd
  * Performs a `select` operation. This will select specified bins of 
  * the requested record.
  *
- *		client.key(ns,set,key).select("a","b","c")
+ *		client.key(ns,set,key).select(["a","b","c"])
+ *
  */
-// PyObject * AerospikeKey_Select(AerospikeKey * self, PyObject * args, PyObject * kwds);
+PyObject * AerospikeKey_Select(AerospikeKey * self, PyObject * args, PyObject * kwds);
 
 /**
  * Performs a `put` operation. This will select specified bins of the 
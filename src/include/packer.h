@@ -0,0 +1,135 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <aerospike/as_error.h>
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/**
+ * The depth of nested lists and dicts at which the codec gives up, rather
+ * than overflow the stack on a cyclic value.
+ */
+#define PACK_MAX_DEPTH 256
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+/**
+ * A growable buffer of MessagePack data. The buffer is heap allocated, and
+ * released by the owner of the data with free().
+ */
+typedef struct {
+	uint8_t * data;
+	size_t size;
+	size_t capacity;
+} pack_buffer;
+
+typedef struct unpack_reader_s unpack_reader;
+
+/**
+ * Converts the payload of an ext value, of the given type.
+ */
+typedef as_status (* unpack_ext_fn)(unpack_reader * r, as_error * err, int8_t type, const uint8_t * data, uint32_t size, PyObject ** py_obj);
+
+/**
+ * Reads MessagePack data. Ext values are passed to the ext function, and are
+ * an error without one.
+ */
+struct unpack_reader_s {
+	const uint8_t * pos;
+	const uint8_t * end;
+	unpack_ext_fn ext;
+	void * udata;
+};
+
+/*******************************************************************************
+ * ENCODER FUNCTIONS
+ *
+ * The encoder functions do not use the Python API, except pack_pyobject(), so
+ * they may run without the GIL.
+ ******************************************************************************/
+
+/**
+ * Grows the buffer by n bytes, and returns the start of them.
+ */
+uint8_t * pack_reserve(pack_buffer * b, size_t n);
+
+void pack_nil(pack_buffer * b);
+
+void pack_int(pack_buffer * b, int64_t v);
+
+void pack_double(pack_buffer * b, double d);
+
+void pack_str(pack_buffer * b, const char * data, size_t size);
+
+void pack_bin(pack_buffer * b, const uint8_t * data, size_t size);
+
+void pack_ext(pack_buffer * b, int8_t type, const uint8_t * data, size_t size);
+
+void pack_array_header(pack_buffer * b, size_t size);
+
+void pack_map_header(pack_buffer * b, size_t size);
+
+/**
+ * Encodes None, bool, int, long, float, str, unicode, bytearray, list, tuple
+ * and dict values. Requires the GIL.
+ */
+as_status pack_pyobject(as_error * err, pack_buffer * b, PyObject * py_obj, int depth);
+
+/*******************************************************************************
+ * DECODER FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * Reads the header of a map, the count of its entries.
+ */
+as_status unpack_map_header(unpack_reader * r, as_error * err, size_t * size);
+
+/**
+ * Reads a str value in place.
+ */
+as_status unpack_str(unpack_reader * r, as_error * err, const char ** data, size_t * size);
+
+/**
+ * Reads an unsigned integer value.
+ */
+as_status unpack_uint(unpack_reader * r, as_error * err, uint64_t * v);
+
+/**
+ * Decodes a value into a Python object. Arrays decode as lists, str as str,
+ * and bin as bytearray, except for map keys, which decode as str. Map entries
+ * with other keys which are not hashable, such as lists, are skipped. Requires
+ * the GIL.
+ */
+as_status unpack_pyobject(unpack_reader * r, as_error * err, PyObject ** py_obj, int depth);
+
+/**
+ * Turns a bytearray, which is not hashable, into a str, so that bytes map
+ * keys can be dict keys. Steals the reference to py_key, and returns a new
+ * one. Shared by the decoder and the conversion of as_map values, so both
+ * read a map alike. Requires the GIL.
+ */
+PyObject * unpack_map_key(PyObject * py_key);
@@ -17,15 +17,26 @@
 #include <Python.h>
 #include <aerospike/as_error.h>
 #include <aerospike/as_policy.h>
+#include <aerospike/as_scan.h>
+
+#include "compression.h"
 
 as_status pyobject_to_policy_apply(as_error * err, PyObject * py_policy,
 									as_policy_apply * policy,
 									as_policy_apply ** policy_p);
 
+as_status pyobject_to_policy_batch(as_error * err, PyObject * py_policy,
+									as_policy_batch * policy,
+									as_policy_batch ** policy_p);
+
 as_status pyobject_to_policy_info(as_error * err, PyObject * py_policy,
 									as_policy_info * policy,
 									as_policy_info ** policy_p);
 
+as_status pyobject_to_policy_operate(as_error * err, PyObject * py_policy,
+									as_policy_operate * policy,
+									as_policy_operate ** policy_p);
+
 as_status pyobject_to_policy_query(as_error * err, PyObject * py_policy,
 									as_policy_query * policy,
 									as_policy_query ** policy_p);
@@ -45,3 +56,17 @@ as_status pyobject_to_policy_scan(as_error * err, PyObject * py_policy,
 as_status pyobject_to_policy_write(as_error * err, PyObject * py_policy,
 									as_policy_write * policy,
 									as_policy_write ** policy_p);
+
+/**
+ * Reads the 'compress_threshold' and 'compress_level' of a client config or
+ * write policy dict, over the given defaults.
+ */
+as_status pyobject_to_compression(as_error * err, PyObject * py_dict,
+									const compression * defaults,
+									compression * c);
+
+/**
+ * Applies the 'priority', 'percent', 'nobins' and 'concurrent' options of a
+ * scan, from a dict.
+ */
+as_status pyobject_to_scan_options(as_error * err, PyObject * py_options, as_scan * scan);
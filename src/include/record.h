@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include <aerospike/as_error.h>
+#include <aerospike/as_key.h>
+#include <aerospike/as_record.h>
+
+#include "types.h"
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+PyTypeObject * AerospikeRecord_Ready(void);
+
+/**
+ * Creates a record object, taking ownership of the heap allocated record.
+ * Sets *rec to NULL. The bins are converted when they are first accessed.
+ * The key is converted by result_key_to_pyobject().
+ */
+PyObject * AerospikeRecord_New(as_error * err, as_record ** rec, const as_key * key, PyObject * py_key, AerospikeClient * client);
+
+/**
+ * Creates a record object from a record owned by the caller, such as the
+ * records of scan, query and batch callbacks. The bin values are moved out
+ * of the caller's record where possible, rather than copied, so the caller's
+ * record must only be destroyed afterwards.
+ */
+PyObject * AerospikeRecord_Retain(as_error * err, const as_record * rec, const as_key * key, AerospikeClient * client);
+
+/**
+ * Converts a result of a scan or query. A record becomes a Record, when the
+ * client is configured with 'lazy_records', or a (key, meta, bins) tuple
+ * otherwise. Other values are converted by val_to_pyobject().
+ */
+as_status result_to_pyobject(as_error * err, const as_val * val, AerospikeClient * client, PyObject ** obj);
+
+/*******************************************************************************
+ * OPERATIONS
+ ******************************************************************************/
+
+/**
+ * Returns the value of a bin, converting it if it was not yet accessed, or
+ * the default when the record has no such bin.
+ *
+ *		record.get(bin, default)
+ *
+ */
+PyObject * AerospikeRecord_Get(AerospikeRecord * self, PyObject * args, PyObject * kwds);
+
+/**
+ * Returns the bins of the record as a UTF-8 JSON string. Bins which were not
+ * yet accessed are encoded straight from the record, without converting them.
+ *
+ *		record.to_json()
+ *
+ */
+PyObject * AerospikeRecord_To_Json(AerospikeRecord * self, PyObject * args, PyObject * kwds);
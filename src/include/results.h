@@ -0,0 +1,223 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <aerospike/as_error.h>
+#include <aerospike/as_val.h>
+
+#include "cancel.h"
+#include "packer.h"
+#include "types.h"
+
+/*******************************************************************************
+ * CONSTANTS
+ ******************************************************************************/
+
+/**
+ * How often a thread waiting on a scan or query wakes up, to check for 
+ * signals and cancellation.
+ */
+#define RESULTS_WAIT_MS 100
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+/**
+ * Receives each result of a batch, or a list of results when the batch has a
+ * batch size, with the GIL held. The result is borrowed. Returning false 
+ * stops the scan or query, and a Python exception set by the callback is 
+ * raised once the scan or query returns.
+ */
+typedef bool (* results_batch_callback)(PyObject * py_result, void * udata);
+
+/**
+ * Runs a scan or query, populating err with the error of the operation.
+ */
+typedef void (* results_run_fn)(as_error * err, void * udata);
+
+/**
+ * Collects the results of a scan or query from the node threads, and hands
+ * them to a callback in batches, to take the GIL once per batch rather than
+ * once per result.
+ *
+ * The node threads flatten each result into MessagePack without the GIL, in
+ * parallel, and append it to the pending buffer. The thread which fills the
+ * buffer takes it, and converts its results to Python objects under the GIL.
+ *
+ * With a batch size, the converted results are collected into lists of that
+ * many results. With a maximum delay, pending results and partial lists are
+ * handed over once the oldest of them has waited that long. The delay is
+ * checked as results arrive, and by results_batch_run() while it waits, so
+ * results are not held back when the scan goes quiet. The results left are
+ * handed over when the scan or query ends.
+ *
+ * The batch stops once the callback returns false or raises, once `limit`
+ * results were added, or once the cancel token is cancelled.
+ */
+typedef struct {
+	AerospikeClient * client;
+	results_batch_callback callback;
+	void * udata;
+	uint32_t batch_size;
+	int64_t max_delay_ms;
+
+	pthread_mutex_t lock;
+	pack_buffer pending;
+	uint32_t n_pending;
+	uint32_t max_pending;
+	int64_t pending_since;
+
+	PyObject * py_batch;
+	int64_t batch_since;
+
+	// Optional, set after init
+	uint32_t limit;
+	AerospikeCancelToken * cancel;
+	uint32_t n_added;
+
+	bool stopped;
+	as_error error;
+	PyObject * py_exc_type;
+	PyObject * py_exc_value;
+	PyObject * py_exc_traceback;
+} results_batch;
+
+/**
+ * A chunk of results in a queue, either flattened results, or a single
+ * result which was converted directly.
+ */
+typedef struct results_chunk_s {
+	struct results_chunk_s * next;
+	pack_buffer flat;
+	size_t pos;
+	uint32_t n_results;
+	PyObject * py_result;
+} results_chunk;
+
+/**
+ * A bounded queue of the results of a scan or query, from the node threads
+ * to a consumer on another thread. The node threads block while the queue is
+ * full, so the memory held by the queue stays bounded however many results
+ * there are. The consumer takes a chunk of results at a time.
+ *
+ * The node threads stop adding results once `limit` results were added, or
+ * once the cancel token is cancelled.
+ */
+typedef struct {
+	AerospikeClient * client;
+
+	pthread_mutex_t lock;
+	pthread_cond_t not_full;
+	pthread_cond_t not_empty;
+	results_chunk * head;
+	results_chunk * tail;
+	uint32_t n_queued;
+	size_t bytes_queued;
+
+	// Optional, set after init
+	uint32_t limit;
+	AerospikeCancelToken * cancel;
+	uint32_t n_added;
+
+	bool stopped;
+	bool done;
+	as_error error;
+} results_queue;
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * Initializes the batch. A batch size of 0 hands the results to the callback
+ * one by one, and a maximum delay of 0 lets results wait until a batch fills
+ * up. Requires the GIL.
+ */
+void results_batch_init(results_batch * batch, AerospikeClient * client, uint32_t batch_size, uint32_t max_delay_ms, results_batch_callback callback, void * udata);
+
+/**
+ * Adds a result of the scan or query. Called by the node threads, without the
+ * GIL. Returns false once the batch has stopped.
+ */
+bool results_batch_add(results_batch * batch, const as_val * val);
+
+/**
+ * Hands the remaining results to the callback, and releases the batch.
+ * Requires the GIL. Returns false when the callback raised an exception,
+ * which is restored, and sets err when a result could not be converted.
+ */
+bool results_batch_finish(results_batch * batch, as_error * err);
+
+/**
+ * Runs the scan or query on a native thread, while the calling thread waits
+ * for it without the GIL. The calling thread wakes up regularly to check for
+ * signals and for the cancel token, and stops the batch when either is set.
+ * The exception of a signal handler is raised by results_batch_finish().
+ * Requires the GIL.
+ */
+void results_batch_run(results_batch * batch, results_run_fn run, void * udata, as_error * err);
+
+void results_queue_init(results_queue * queue, AerospikeClient * client);
+
+/**
+ * Adds a result of the scan or query. Called by the node threads, without the
+ * GIL. Blocks while the queue is full. Returns false once the queue has
+ * stopped.
+ */
+bool results_queue_add(results_queue * queue, const as_val * val);
+
+/**
+ * Marks the end of the results, with the error of the scan or query, if any.
+ * Does not require the GIL.
+ */
+void results_queue_done(results_queue * queue, const as_error * err);
+
+/**
+ * Stops the queue, so that the node threads stop adding results. Does not
+ * require the GIL.
+ */
+void results_queue_stop(results_queue * queue);
+
+/**
+ * Takes the queued results, waiting up to timeout_ms until there are any.
+ * Returns NULL when none arrived in time, or once all results were taken, in
+ * which case *done is set, and err is set to the error of the scan or query,
+ * if any. Must be called without the GIL.
+ */
+results_chunk * results_queue_take(results_queue * queue, uint32_t timeout_ms, bool * done, as_error * err);
+
+/**
+ * Releases the queue and the results left in it. Requires the GIL.
+ */
+void results_queue_destroy(results_queue * queue);
+
+/**
+ * Converts the next result of a chunk. Sets *py_result to NULL once all
+ * results of the chunk were converted. Requires the GIL.
+ */
+as_status results_chunk_next(results_chunk * chunk, AerospikeClient * client, as_error * err, PyObject ** py_result);
+
+/**
+ * Releases a chunk and the results left in it. Requires the GIL.
+ */
+void results_chunk_destroy(results_chunk * chunk);
@@ -66,11 +66,30 @@ AerospikeScan * AerospikeScan_Select(AerospikeScan * self, PyObject * args, PyOb
  *
  *    query.foreach(each_result)
  *
+ * With a batch_size, the callback is called with lists of up to that many
+ * results instead. With max_delay_ms, results are handed to the callback 
+ * once they have waited that long, as further results arrive.
+ *
+ *    def each_batch(results):
+ *      print len(results)
+ *
+ *    scan.foreach(each_batch, batch_size=1000, max_delay_ms=100)
+ *
+ * The scan stops at the next result of each node once the callback returns
+ * False or raises an exception, once `limit` results were handed over, once
+ * the `cancel` token (an aerospike.CancelToken) is cancelled, or once a 
+ * signal handler raises, such as on Ctrl-C. Exceptions are raised by 
+ * foreach().
+ *
  */
 PyObject * AerospikeScan_Foreach(AerospikeScan * self, PyObject * args, PyObject * kwds);
 
 /**
- * Execute the query and return a generator
+ * Execute the scan and return an iterator, which yields the results as they
+ * arrive. Iterating over the scan itself does the same.
+ *
+ * The scan stops once `limit` results were yielded, or once the `cancel`
+ * token is cancelled.
  *
  *    for result in query.results():
  *      print result
@@ -0,0 +1,110 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include <aerospike/as_error.h>
+#include <aerospike/as_key.h>
+#include <aerospike/as_record.h>
+
+#include "arena.h"
+#include "conversions.h"
+#include "types.h"
+#include "client.h"
+
+/**
+ * A bin of the schema. The converter is resolved from the declared type when
+ * the schema is created, and is NULL for bins which accept any type.
+ */
+struct schema_field_s {
+	as_bin_name name;
+	PyTypeObject * type;
+	pyobject_to_val_fn convert;
+};
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+PyTypeObject * AerospikeSchema_Ready(void);
+
+AerospikeSchema * AerospikeSchema_New(AerospikeClient * client, PyObject * args, PyObject * kwds);
+
+/**
+ * Converts a key of the schema's set. Either a (ns, set, key) tuple, or only
+ * the key, which is then in the namespace and set of the schema.
+ */
+as_status AerospikeSchema_Key(AerospikeSchema * self, as_error * err, PyObject * py_key, as_key * key);
+
+/**
+ * Converts a record to a row, with the bins in the order of the schema. The
+ * bins missing from the record are None, and the bins which are not in the
+ * schema are ignored.
+ */
+as_status AerospikeSchema_Row_From_Record(AerospikeSchema * self, as_error * err, const as_record * rec, PyObject ** py_row);
+
+/**
+ * Converts a sequence of values, in the order of the schema, to a record. The
+ * values of the declared type are converted without looking up their type.
+ * On error, the err argument is populated, and the record is destroyed.
+ */
+as_status AerospikeSchema_Row_To_Record(AerospikeSchema * self, as_error * err, PyObject * py_row, PyObject * py_meta, as_record * rec, arena * arena);
+
+/*******************************************************************************
+ * OPERATIONS
+ ******************************************************************************/
+
+/**
+ * Read the bins of the schema of a record, as a row. Returns None if the 
+ * record does not exist.
+ *
+ *		row = schema.get(key)
+ *		print row.name, row.age
+ *
+ */
+PyObject * AerospikeSchema_Get(AerospikeSchema * self, PyObject * args, PyObject * kwds);
+
+/**
+ * Write a record from a tuple of values, in the order of the schema.
+ *
+ *		schema.put(key, ("bob", 42))
+ *
+ */
+PyObject * AerospikeSchema_Put(AerospikeSchema * self, PyObject * args, PyObject * kwds);
+
+/**
+ * Scan the set of the schema, and call the callback with each row. The scan
+ * stops when the callback returns False or raises an exception.
+ *
+ *		def each_row(row):
+ *			print row
+ *
+ *		schema.foreach(each_row)
+ *
+ */
+PyObject * AerospikeSchema_Foreach(AerospikeSchema * self, PyObject * args, PyObject * kwds);
+
+/**
+ * Scan the set of the schema, and return a list of the rows.
+ *
+ *		for row in schema.results():
+ *			print row
+ *
+ */
+PyObject * AerospikeSchema_Results(AerospikeSchema * self, PyObject * args, PyObject * kwds);
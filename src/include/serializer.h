@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <stdint.h>
+
+#include <aerospike/as_error.h>
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+typedef enum {
+	SERIALIZER_NONE		= 0,
+	SERIALIZER_MSGPACK	= 1,
+	SERIALIZER_USER		= 2
+} serializer_type;
+
+/**
+ * Converts the values of the types the client does not support to bytes, and
+ * back. The bytes are stored with the AS_BYTES_PYTHON type, so they can be
+ * told apart from plain bytearrays on read.
+ */
+typedef struct {
+	serializer_type type;
+	PyObject * func;
+} serializer;
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * Initializes a serializer from a client config entry: either the 
+ * aerospike.SERIALIZER_MSGPACK constant, for the native MessagePack codec,
+ * or a callable. A missing entry or None disables the serializer, anything
+ * else is an AEROSPIKE_ERR_PARAM error.
+ */
+as_status serializer_init(serializer * s, as_error * err, PyObject * py_config);
+
+void serializer_destroy(serializer * s);
+
+/**
+ * Serializes a value into a heap allocated buffer, which the caller frees.
+ * Requires the GIL.
+ */
+as_status serializer_dump(const serializer * s, as_error * err, PyObject * py_obj, uint8_t ** data, uint32_t * size);
+
+/**
+ * Deserializes a value from the bytes produced by serializer_dump(). 
+ * Requires the GIL.
+ */
+as_status serializer_load(const serializer * s, as_error * err, const uint8_t * data, uint32_t size, PyObject ** py_obj);
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <Python.h>
+#include <pthread.h>
+#include <stdbool.h>
+
+#include <aerospike/as_policy.h>
+#include <aerospike/as_query.h>
+#include <aerospike/as_scan.h>
+
+#include "types.h"
+#include "results.h"
+
+/*******************************************************************************
+ * TYPES
+ ******************************************************************************/
+
+/**
+ * An iterator over the results of a scan or query. The scan or query runs on
+ * a native thread, and its results flow to the iterator through a bounded 
+ * queue, so results are yielded as soon as they arrive, and the memory held
+ * stays bounded however many results there are.
+ */
+typedef struct {
+	PyObject_HEAD
+	AerospikeClient * client;
+	PyObject * source;
+
+	as_scan * scan;
+	as_policy_scan scan_policy;
+	as_policy_scan * scan_policy_p;
+
+	as_query * query;
+	as_policy_query query_policy;
+	as_policy_query * query_policy_p;
+
+	AerospikeCancelToken * cancel;
+	results_queue queue;
+	results_chunk * chunk;
+	pthread_t thread;
+	bool running;
+} AerospikeStream;
+
+/*******************************************************************************
+ * FUNCTIONS
+ ******************************************************************************/
+
+PyTypeObject * AerospikeStream_Ready(void);
+
+/**
+ * Starts the scan, and returns an iterator over its results. The policy and
+ * the cancel token are optional, and a limit of 0 yields all results.
+ */
+AerospikeStream * AerospikeStream_Scan(AerospikeScan * scan, const as_policy_scan * policy, uint32_t limit, AerospikeCancelToken * cancel);
+
+/**
+ * Starts the query, and returns an iterator over its results. The policy and
+ * the cancel token are optional, and a limit of 0 yields all results.
+ */
+AerospikeStream * AerospikeStream_Query(AerospikeQuery * query, const as_policy_query * policy, uint32_t limit, AerospikeCancelToken * cancel);
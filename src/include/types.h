@@ -22,12 +22,28 @@
 #include <aerospike/aerospike.h>
 #include <aerospike/as_key.h>
 #include <aerospike/as_query.h>
+#include <aerospike/as_record.h>
 #include <aerospike/as_scan.h>
 
+#include "async.h"
+#include "compression.h"
+#include "intern.h"
+#include "serializer.h"
 
 typedef struct {
 	PyObject_HEAD
 	aerospike * as;
+	async_engine * async;
+	uint32_t async_threads;
+	uint32_t async_max_pending;
+	bool bytes_view;
+	bool lazy_records;
+	bool reuse_keys;
+	compression compression;
+	bool decompress;
+	intern_table * bin_names;
+	serializer serializer;
+	serializer deserializer;
 } AerospikeClient;
 
 typedef struct {
@@ -48,4 +64,53 @@ typedef struct {
   PyObject_HEAD
   AerospikeClient * client;
   as_scan scan;
-} AerospikeScan;
\ No newline at end of file
+} AerospikeScan;
+
+/**
+ * The client of a future is borrowed, and cleared once the future completes.
+ * Closing the client completes all of its futures, so the client outlives the
+ * futures which refer to it, and pending futures do not keep it alive.
+ */
+typedef struct {
+	PyObject_HEAD
+	AerospikeClient * client;
+	PyObject * result;
+	PyObject * error;
+	PyObject * callbacks;
+	bool done;
+} AerospikeFuture;
+
+typedef struct {
+	PyObject_HEAD
+	PyObject * owner;
+	const uint8_t * data;
+	Py_ssize_t size;
+} AerospikeBytesView;
+
+typedef struct {
+	PyObject_HEAD
+	bool cancelled;
+} AerospikeCancelToken;
+
+typedef struct {
+	PyObject_HEAD
+	PyObject * key;
+	PyObject * meta;
+	PyObject * bins;
+	PyObject * owner;
+	const as_record * rec;
+	AerospikeClient * client;
+} AerospikeRecord;
+
+typedef struct schema_field_s schema_field;
+
+typedef struct {
+	PyObject_HEAD
+	AerospikeClient * client;
+	PyObject * namespace;
+	PyObject * set;
+	PyTypeObject * row_type;
+	schema_field * fields;
+	const char ** bins;
+	uint16_t n_fields;
+} AerospikeSchema;
\ No newline at end of file
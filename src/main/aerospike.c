@@ -19,10 +19,20 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <aerospike/as_operations.h>
+#include <aerospike/as_scan.h>
+
 #include "client.h"
 #include "key.h"
 #include "query.h"
 #include "scan.h"
+#include "future.h"
+#include "bytes_view.h"
+#include "cancel.h"
+#include "record.h"
+#include "schema.h"
+#include "stream.h"
+#include "serializer.h"
 #include "predicates.h"
 
 static PyMethodDef Aerospike_Methods[] = {
@@ -58,6 +68,47 @@ PyMODINIT_FUNC initaerospike()
 	Py_INCREF(scan);
 	PyModule_AddObject(aerospike, "Scan", (PyObject *) scan);
 
+	PyTypeObject * future = AerospikeFuture_Ready();
+	Py_INCREF(future);
+	PyModule_AddObject(aerospike, "Future", (PyObject *) future);
+
+	PyTypeObject * bytes_view = AerospikeBytesView_Ready();
+	Py_INCREF(bytes_view);
+	PyModule_AddObject(aerospike, "BytesView", (PyObject *) bytes_view);
+
+	PyTypeObject * cancel = AerospikeCancelToken_Ready();
+	Py_INCREF(cancel);
+	PyModule_AddObject(aerospike, "CancelToken", (PyObject *) cancel);
+
+	PyTypeObject * record = AerospikeRecord_Ready();
+	Py_INCREF(record);
+	PyModule_AddObject(aerospike, "Record", (PyObject *) record);
+
+	PyTypeObject * stream = AerospikeStream_Ready();
+	Py_INCREF(stream);
+	PyModule_AddObject(aerospike, "ResultStream", (PyObject *) stream);
+
+	PyTypeObject * schema = AerospikeSchema_Ready();
+	Py_INCREF(schema);
+	PyModule_AddObject(aerospike, "Schema", (PyObject *) schema);
+
 	PyObject * predicates = AerospikePredicates_New();
 	PyModule_AddObject(aerospike, "predicates", predicates);
+
+	// Operators for client.operate()
+	PyModule_AddIntConstant(aerospike, "OPERATOR_READ", AS_OPERATOR_READ);
+	PyModule_AddIntConstant(aerospike, "OPERATOR_WRITE", AS_OPERATOR_WRITE);
+	PyModule_AddIntConstant(aerospike, "OPERATOR_INCR", AS_OPERATOR_INCR);
+	PyModule_AddIntConstant(aerospike, "OPERATOR_APPEND", AS_OPERATOR_APPEND);
+	PyModule_AddIntConstant(aerospike, "OPERATOR_PREPEND", AS_OPERATOR_PREPEND);
+	PyModule_AddIntConstant(aerospike, "OPERATOR_TOUCH", AS_OPERATOR_TOUCH);
+
+	// Priorities for the 'priority' option of client.scan()
+	PyModule_AddIntConstant(aerospike, "SCAN_PRIORITY_AUTO", AS_SCAN_PRIORITY_AUTO);
+	PyModule_AddIntConstant(aerospike, "SCAN_PRIORITY_LOW", AS_SCAN_PRIORITY_LOW);
+	PyModule_AddIntConstant(aerospike, "SCAN_PRIORITY_MEDIUM", AS_SCAN_PRIORITY_MEDIUM);
+	PyModule_AddIntConstant(aerospike, "SCAN_PRIORITY_HIGH", AS_SCAN_PRIORITY_HIGH);
+
+	// Native serializer for the 'serializer' and 'deserializer' client config
+	PyModule_AddIntConstant(aerospike, "SERIALIZER_MSGPACK", SERIALIZER_MSGPACK);
 }
@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <stdlib.h>
+
+#include "arena.h"
+
+#define ARENA_ALIGN 16
+#define ARENA_BLOCK_SIZE 8192
+
+struct arena_block_s {
+	arena_block * next;
+	union {
+		uint8_t data[1];
+		long double align;
+	} u;
+};
+
+struct arena_cleanup_s {
+	arena_cleanup * next;
+	arena_cleanup_fn fn;
+	void * data;
+};
+
+void arena_init(arena * a)
+{
+	a->pos = a->inline_block.data;
+	a->end = a->inline_block.data + ARENA_INLINE_SIZE;
+	a->blocks = NULL;
+	a->cleanups = NULL;
+}
+
+void * arena_alloc(arena * a, size_t size)
+{
+	size = (size + ARENA_ALIGN - 1) & ~((size_t) ARENA_ALIGN - 1);
+
+	if ( size > (size_t) (a->end - a->pos) ) {
+		// Large allocations get a block of their own
+		size_t block_size = size > ARENA_BLOCK_SIZE ? size : ARENA_BLOCK_SIZE;
+		arena_block * block = (arena_block *) malloc(offsetof(arena_block, u) + block_size);
+		if ( block == NULL ) {
+			return NULL;
+		}
+		block->next = a->blocks;
+		a->blocks = block;
+		a->pos = block->u.data;
+		a->end = block->u.data + block_size;
+	}
+
+	void * p = a->pos;
+	a->pos += size;
+	return p;
+}
+
+bool arena_defer(arena * a, arena_cleanup_fn fn, void * data)
+{
+	arena_cleanup * cleanup = (arena_cleanup *) arena_alloc(a, sizeof(arena_cleanup));
+	if ( cleanup == NULL ) {
+		return false;
+	}
+	cleanup->next = a->cleanups;
+	cleanup->fn = fn;
+	cleanup->data = data;
+	a->cleanups = cleanup;
+	return true;
+}
+
+void arena_destroy(arena * a)
+{
+	for ( arena_cleanup * cleanup = a->cleanups; cleanup != NULL; cleanup = cleanup->next ) {
+		cleanup->fn(cleanup->data);
+	}
+
+	arena_block * block = a->blocks;
+	while ( block != NULL ) {
+		arena_block * next = block->next;
+		free(block);
+		block = next;
+	}
+	arena_init(a);
+}
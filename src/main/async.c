@@ -0,0 +1,330 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+#include <aerospike/aerospike_key.h>
+#include <aerospike/as_error.h>
+
+#include "async.h"
+
+/**
+ * The engine is a pool of threads executing jobs from the `pending` queue.
+ * Completed jobs are pushed to the `done` list and announced through an
+ * eventfd (or a pipe, where eventfd is not available), so an event loop can
+ * watch a single file descriptor for all of the outstanding operations.
+ *
+ * The client owns a reference to the engine, and waiters take their own
+ * while they poll the file descriptor without the GIL, so a concurrent close
+ * only stops the threads and the memory and descriptor outlive the waiters.
+ */
+struct async_engine_s {
+	aerospike * as;
+	pthread_mutex_t lock;
+	pthread_cond_t work;
+	async_job * pending_head;
+	async_job * pending_tail;
+	uint32_t npending;
+	uint32_t max_pending;
+	async_job * done;
+	bool closed;
+	uint32_t refs;
+	int fds[2];
+	uint32_t nthreads;
+	pthread_t threads[];
+};
+
+/*******************************************************************************
+ * SIGNALING
+ ******************************************************************************/
+
+static int async_signal_open(int fds[2])
+{
+#ifdef __linux__
+	fds[0] = fds[1] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	return fds[0] < 0 ? -1 : 0;
+#else
+	if ( pipe(fds) != 0 ) {
+		return -1;
+	}
+	for ( int i = 0; i < 2; i++ ) {
+		fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+		fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+	}
+	return 0;
+#endif
+}
+
+static void async_signal_close(int fds[2])
+{
+	close(fds[0]);
+	if ( fds[1] != fds[0] ) {
+		close(fds[1]);
+	}
+}
+
+static void async_signal_notify(int fds[2])
+{
+	uint64_t one = 1;
+	ssize_t rc;
+	do {
+		rc = write(fds[1], &one, fds[1] == fds[0] ? sizeof(uint64_t) : 1);
+	} while ( rc < 0 && errno == EINTR );
+}
+
+static void async_signal_clear(int fds[2])
+{
+	uint64_t buf[8];
+	while ( read(fds[0], buf, sizeof(buf)) > 0 ) {
+		if ( fds[1] == fds[0] ) {
+			break;
+		}
+	}
+}
+
+/*******************************************************************************
+ * JOBS
+ ******************************************************************************/
+
+async_job * async_job_new(async_op op)
+{
+	async_job * job = (async_job *) calloc(1, sizeof(async_job));
+	job->op = op;
+	arena_init(&job->arena);
+	as_error_init(&job->err);
+	return job;
+}
+
+void async_job_destroy(async_job * job)
+{
+	if ( job->rec_initialized ) {
+		as_record_destroy(&job->rec);
+	}
+	if ( job->arglist ) {
+		as_list_destroy(job->arglist);
+	}
+	if ( job->result_rec ) {
+		as_record_destroy(job->result_rec);
+	}
+	if ( job->result_val ) {
+		as_val_destroy(job->result_val);
+	}
+	as_key_destroy(&job->key);
+	arena_destroy(&job->arena);
+	free(job);
+}
+
+static void async_job_execute(aerospike * as, async_job * job)
+{
+	switch ( job->op ) {
+		case ASYNC_OP_GET:
+			aerospike_key_get(as, &job->err, job->policy_p, &job->key, &job->result_rec);
+			break;
+		case ASYNC_OP_PUT:
+			if ( compression_compress_record(&job->err, &job->compression, &job->rec, &job->arena) == AEROSPIKE_OK ) {
+				aerospike_key_put(as, &job->err, job->policy_p, &job->key, &job->rec);
+			}
+			break;
+		case ASYNC_OP_EXISTS:
+			aerospike_key_exists(as, &job->err, job->policy_p, &job->key, &job->result_rec);
+			break;
+		case ASYNC_OP_REMOVE:
+			aerospike_key_remove(as, &job->err, job->policy_p, &job->key);
+			break;
+		case ASYNC_OP_APPLY:
+			aerospike_key_apply(as, &job->err, job->policy_p, &job->key,
+				job->module, job->function, job->arglist, &job->result_val);
+			break;
+	}
+}
+
+/*******************************************************************************
+ * ENGINE
+ ******************************************************************************/
+
+static void * async_engine_worker(void * udata)
+{
+	async_engine * engine = (async_engine *) udata;
+
+	while ( true ) {
+
+		pthread_mutex_lock(&engine->lock);
+
+		while ( engine->pending_head == NULL && ! engine->closed ) {
+			pthread_cond_wait(&engine->work, &engine->lock);
+		}
+
+		async_job * job = engine->pending_head;
+
+		if ( job == NULL ) {
+			pthread_mutex_unlock(&engine->lock);
+			break;
+		}
+
+		engine->pending_head = job->next;
+		if ( engine->pending_head == NULL ) {
+			engine->pending_tail = NULL;
+		}
+		engine->npending--;
+
+		pthread_mutex_unlock(&engine->lock);
+
+		async_job_execute(engine->as, job);
+
+		pthread_mutex_lock(&engine->lock);
+		job->next = engine->done;
+		engine->done = job;
+		pthread_mutex_unlock(&engine->lock);
+
+		async_signal_notify(engine->fds);
+	}
+
+	return NULL;
+}
+
+async_engine * async_engine_new(aerospike * as, uint32_t nthreads, uint32_t max_pending)
+{
+	async_engine * engine = (async_engine *) calloc(1, sizeof(async_engine) + sizeof(pthread_t) * nthreads);
+
+	if ( async_signal_open(engine->fds) != 0 ) {
+		free(engine);
+		return NULL;
+	}
+
+	engine->as = as;
+	engine->refs = 1;
+	engine->max_pending = max_pending;
+	pthread_mutex_init(&engine->lock, NULL);
+	pthread_cond_init(&engine->work, NULL);
+
+	for ( ; engine->nthreads < nthreads; engine->nthreads++ ) {
+		if ( pthread_create(&engine->threads[engine->nthreads], NULL, async_engine_worker, engine) != 0 ) {
+			break;
+		}
+	}
+
+	if ( engine->nthreads == 0 ) {
+		async_engine_destroy(engine);
+		return NULL;
+	}
+
+	return engine;
+}
+
+bool async_engine_submit(async_engine * engine, async_job * job)
+{
+	job->next = NULL;
+
+	pthread_mutex_lock(&engine->lock);
+
+	if ( engine->max_pending > 0 && engine->npending >= engine->max_pending ) {
+		pthread_mutex_unlock(&engine->lock);
+		return false;
+	}
+
+	if ( engine->pending_tail ) {
+		engine->pending_tail->next = job;
+	}
+	else {
+		engine->pending_head = job;
+	}
+	engine->pending_tail = job;
+	engine->npending++;
+
+	pthread_cond_signal(&engine->work);
+	pthread_mutex_unlock(&engine->lock);
+
+	return true;
+}
+
+int async_engine_fd(async_engine * engine)
+{
+	return engine->fds[0];
+}
+
+void async_engine_wait(async_engine * engine, int timeout_ms)
+{
+	struct pollfd pfd = {
+		.fd = engine->fds[0],
+		.events = POLLIN,
+		.revents = 0
+	};
+	poll(&pfd, 1, timeout_ms);
+}
+
+async_job * async_engine_completed(async_engine * engine)
+{
+	async_signal_clear(engine->fds);
+
+	pthread_mutex_lock(&engine->lock);
+	async_job * done = engine->done;
+	engine->done = NULL;
+	pthread_mutex_unlock(&engine->lock);
+
+	return done;
+}
+
+void async_engine_retain(async_engine * engine)
+{
+	__atomic_add_fetch(&engine->refs, 1, __ATOMIC_RELAXED);
+}
+
+void async_engine_release(async_engine * engine)
+{
+	if ( __atomic_sub_fetch(&engine->refs, 1, __ATOMIC_ACQ_REL) > 0 ) {
+		return;
+	}
+
+	async_signal_close(engine->fds);
+	pthread_cond_destroy(&engine->work);
+	pthread_mutex_destroy(&engine->lock);
+	free(engine);
+}
+
+async_job * async_engine_destroy(async_engine * engine)
+{
+	pthread_mutex_lock(&engine->lock);
+	engine->closed = true;
+	pthread_cond_broadcast(&engine->work);
+	pthread_mutex_unlock(&engine->lock);
+
+	for ( uint32_t i = 0; i < engine->nthreads; i++ ) {
+		pthread_join(engine->threads[i], NULL);
+	}
+
+	pthread_mutex_lock(&engine->lock);
+	async_job * done = engine->done;
+	engine->done = NULL;
+	pthread_mutex_unlock(&engine->lock);
+
+	// Wake the waiters, which find the client closed
+	async_signal_notify(engine->fds);
+
+	async_engine_release(engine);
+
+	return done;
+}
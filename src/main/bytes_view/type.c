@@ -0,0 +1,179 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <structmember.h>
+#include <stdbool.h>
+
+#include "bytes_view.h"
+
+/*******************************************************************************
+ * PYTHON TYPE METHODS
+ ******************************************************************************/
+
+PyObject * AerospikeBytesView_ToBytes(AerospikeBytesView * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, ":tobytes", kwlist) == false ) {
+		return NULL;
+	}
+
+	return PyString_FromStringAndSize((const char *) self->data, self->size);
+}
+
+static PyMethodDef AerospikeBytesView_Type_Methods[] = {
+
+    {"tobytes",	(PyCFunction) AerospikeBytesView_ToBytes,	METH_VARARGS | METH_KEYWORDS,
+    			"Copy the bytes of the view into a string."},
+
+	{NULL}
+};
+
+/*******************************************************************************
+ * PYTHON SEQUENCE & BUFFER PROTOCOLS
+ ******************************************************************************/
+
+static Py_ssize_t AerospikeBytesView_Type_Length(AerospikeBytesView * self)
+{
+	return self->size;
+}
+
+static PySequenceMethods AerospikeBytesView_Type_Sequence = {
+	.sq_length			= (lenfunc) AerospikeBytesView_Type_Length
+};
+
+static Py_ssize_t AerospikeBytesView_Type_ReadBuffer(AerospikeBytesView * self, Py_ssize_t segment, void ** ptr)
+{
+	if ( segment != 0 ) {
+		PyErr_SetString(PyExc_SystemError, "accessing non-existent bytes segment");
+		return -1;
+	}
+	*ptr = (void *) self->data;
+	return self->size;
+}
+
+static Py_ssize_t AerospikeBytesView_Type_SegCount(AerospikeBytesView * self, Py_ssize_t * lenp)
+{
+	if ( lenp ) {
+		*lenp = self->size;
+	}
+	return 1;
+}
+
+static int AerospikeBytesView_Type_GetBuffer(AerospikeBytesView * self, Py_buffer * view, int flags)
+{
+	return PyBuffer_FillInfo(view, (PyObject *) self, (void *) self->data, self->size, 1, flags);
+}
+
+static PyBufferProcs AerospikeBytesView_Type_Buffer = {
+	.bf_getreadbuffer	= (readbufferproc) AerospikeBytesView_Type_ReadBuffer,
+	.bf_getwritebuffer	= 0,
+	.bf_getsegcount		= (segcountproc) AerospikeBytesView_Type_SegCount,
+	.bf_getcharbuffer	= (charbufferproc) AerospikeBytesView_Type_ReadBuffer,
+	.bf_getbuffer		= (getbufferproc) AerospikeBytesView_Type_GetBuffer,
+	.bf_releasebuffer	= 0
+};
+
+/*******************************************************************************
+ * PYTHON TYPE HOOKS
+ ******************************************************************************/
+
+static PyObject * AerospikeBytesView_Type_Repr(AerospikeBytesView * self)
+{
+	return PyString_FromFormat("<aerospike.BytesView of %zd bytes>", self->size);
+}
+
+static void AerospikeBytesView_Type_Dealloc(AerospikeBytesView * self)
+{
+	Py_XDECREF(self->owner);
+    self->ob_type->tp_free((PyObject *) self);
+}
+
+/*******************************************************************************
+ * PYTHON TYPE DESCRIPTOR
+ ******************************************************************************/
+
+static PyTypeObject AerospikeBytesView_Type = {
+	PyObject_HEAD_INIT(NULL)
+
+    .ob_size			= 0,
+    .tp_name			= "aerospike.BytesView",
+    .tp_basicsize		= sizeof(AerospikeBytesView),
+    .tp_itemsize		= 0,
+    .tp_dealloc			= (destructor) AerospikeBytesView_Type_Dealloc,
+    .tp_print			= 0,
+    .tp_getattr			= 0,
+    .tp_setattr			= 0,
+    .tp_compare			= 0,
+    .tp_repr			= (reprfunc) AerospikeBytesView_Type_Repr,
+    .tp_as_number		= 0,
+    .tp_as_sequence		= &AerospikeBytesView_Type_Sequence,
+    .tp_as_mapping		= 0,
+    .tp_hash			= 0,
+    .tp_call			= 0,
+    .tp_str				= 0,
+    .tp_getattro		= 0,
+    .tp_setattro		= 0,
+    .tp_as_buffer		= &AerospikeBytesView_Type_Buffer,
+    .tp_flags			= Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_NEWBUFFER,
+    .tp_doc				= 
+    		"The BytesView class is a read-only buffer over the bytes of a bin,\n"
+    		"returned in place of a bytearray when the client is configured with\n"
+    		"'bytes_view'. The bytes are not copied, and remain valid for as long\n"
+    		"as the view is referenced.\n",
+    .tp_traverse		= 0,
+    .tp_clear			= 0,
+    .tp_richcompare		= 0,
+    .tp_weaklistoffset	= 0,
+    .tp_iter			= 0,
+    .tp_iternext		= 0,
+    .tp_methods			= AerospikeBytesView_Type_Methods,
+    .tp_members			= 0,
+    .tp_getset			= 0,
+    .tp_base			= 0,
+    .tp_dict			= 0,
+    .tp_descr_get		= 0,
+    .tp_descr_set		= 0,
+    .tp_dictoffset		= 0,
+    .tp_init			= 0,
+    .tp_alloc			= 0,
+    .tp_new				= 0
+};
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+PyTypeObject * AerospikeBytesView_Ready()
+{
+	return PyType_Ready(&AerospikeBytesView_Type) == 0 ? &AerospikeBytesView_Type : NULL;
+}
+
+PyObject * AerospikeBytesView_New(PyObject * owner, const uint8_t * data, Py_ssize_t size)
+{
+	AerospikeBytesView * self = PyObject_New(AerospikeBytesView, &AerospikeBytesView_Type);
+	if ( self == NULL ) {
+		return NULL;
+	}
+	Py_INCREF(owner);
+	self->owner = owner;
+	self->data = data;
+	self->size = size;
+	return (PyObject *) self;
+}
@@ -0,0 +1,161 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <structmember.h>
+#include <stdbool.h>
+
+#include <aerospike/as_error.h>
+
+#include "cancel.h"
+
+/*******************************************************************************
+ * PYTHON TYPE METHODS
+ ******************************************************************************/
+
+PyObject * AerospikeCancelToken_Cancel(AerospikeCancelToken * self, PyObject * args, PyObject * kwds)
+{
+	__atomic_store_n(&self->cancelled, true, __ATOMIC_RELEASE);
+
+	Py_INCREF(Py_None);
+	return Py_None;
+}
+
+PyObject * AerospikeCancelToken_Is_Cancelled(AerospikeCancelToken * self, PyObject * args, PyObject * kwds)
+{
+	return PyBool_FromLong(AerospikeCancelToken_Cancelled(self));
+}
+
+static PyMethodDef AerospikeCancelToken_Type_Methods[] = {
+
+    {"cancel",		(PyCFunction) AerospikeCancelToken_Cancel,			METH_VARARGS | METH_KEYWORDS,
+    				"Cancel the scans and queries which were given the token."},
+
+    {"cancelled",	(PyCFunction) AerospikeCancelToken_Is_Cancelled,	METH_VARARGS | METH_KEYWORDS,
+    				"Whether the token was cancelled."},
+
+	{NULL}
+};
+
+/*******************************************************************************
+ * PYTHON TYPE HOOKS
+ ******************************************************************************/
+
+static PyObject * AerospikeCancelToken_Type_New(PyTypeObject * type, PyObject * args, PyObject * kwds)
+{
+	AerospikeCancelToken * self = NULL;
+
+    self = (AerospikeCancelToken *) type->tp_alloc(type, 0);
+
+    if ( self == NULL ) {
+    	return NULL;
+    }
+
+	self->cancelled = false;
+
+	return (PyObject *) self;
+}
+
+static void AerospikeCancelToken_Type_Dealloc(AerospikeCancelToken * self)
+{
+    self->ob_type->tp_free((PyObject *) self);
+}
+
+/*******************************************************************************
+ * PYTHON TYPE DESCRIPTOR
+ ******************************************************************************/
+
+static PyTypeObject AerospikeCancelToken_Type = {
+	PyObject_HEAD_INIT(NULL)
+
+    .ob_size			= 0,
+    .tp_name			= "aerospike.CancelToken",
+    .tp_basicsize		= sizeof(AerospikeCancelToken),
+    .tp_itemsize		= 0,
+    .tp_dealloc			= (destructor) AerospikeCancelToken_Type_Dealloc,
+    .tp_print			= 0,
+    .tp_getattr			= 0,
+    .tp_setattr			= 0,
+    .tp_compare			= 0,
+    .tp_repr			= 0,
+    .tp_as_number		= 0,
+    .tp_as_sequence		= 0,
+    .tp_as_mapping		= 0,
+    .tp_hash			= 0,
+    .tp_call			= 0,
+    .tp_str				= 0,
+    .tp_getattro		= 0,
+    .tp_setattro		= 0,
+    .tp_as_buffer		= 0,
+    .tp_flags			= Py_TPFLAGS_DEFAULT,
+    .tp_doc				= 
+    		"A token which cancels scans and queries from another thread. Pass\n"
+    		"it as the 'cancel' argument of foreach() or results(), and call\n"
+    		"cancel() to stop them:\n"
+    		"\n"
+    		"    token = aerospike.CancelToken()\n"
+    		"    threading.Timer(10, token.cancel).start()\n"
+    		"    scan.foreach(callback, cancel=token)\n",
+    .tp_traverse		= 0,
+    .tp_clear			= 0,
+    .tp_richcompare		= 0,
+    .tp_weaklistoffset	= 0,
+    .tp_iter			= 0,
+    .tp_iternext		= 0,
+    .tp_methods			= AerospikeCancelToken_Type_Methods,
+    .tp_members			= 0,
+    .tp_getset			= 0,
+    .tp_base			= 0,
+    .tp_dict			= 0,
+    .tp_descr_get		= 0,
+    .tp_descr_set		= 0,
+    .tp_dictoffset		= 0,
+    .tp_init			= 0,
+    .tp_alloc			= 0,
+    .tp_new				= AerospikeCancelToken_Type_New
+};
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+PyTypeObject * AerospikeCancelToken_Ready()
+{
+	return PyType_Ready(&AerospikeCancelToken_Type) == 0 ? &AerospikeCancelToken_Type : NULL;
+}
+
+bool AerospikeCancelToken_Cancelled(const AerospikeCancelToken * self)
+{
+	return self != NULL && __atomic_load_n(&self->cancelled, __ATOMIC_ACQUIRE);
+}
+
+as_status pyobject_to_cancel_token(as_error * err, PyObject * py_cancel, AerospikeCancelToken ** cancel)
+{
+	as_error_reset(err);
+
+	*cancel = NULL;
+
+	if ( py_cancel == NULL || py_cancel == Py_None ) {
+		return err->code;
+	}
+
+	if ( ! PyObject_TypeCheck(py_cancel, &AerospikeCancelToken_Type) ) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "cancel must be an aerospike.CancelToken");
+	}
+
+	*cancel = (AerospikeCancelToken *) py_cancel;
+	return err->code;
+}
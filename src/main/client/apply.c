@@ -55,7 +55,7 @@ PyObject * AerospikeClient_Apply_Invoke(
 	}
 	
 	// Convert python list to as_list
-	pyobject_to_list(&err, py_arglist, &arglist);
+	pyobject_to_list(self, &err, py_arglist, &arglist, NULL);
 	if ( err.code != AEROSPIKE_OK ) {
 		goto CLEANUP;
 	}
@@ -69,11 +69,13 @@ PyObject * AerospikeClient_Apply_Invoke(
 	module = PyString_AsString(py_module);
 	function = PyString_AsString(py_function);
 
-	// Invoke operation
+	// Invoke operation, without holding the GIL while waiting on the network
+	PyThreadState * _save = PyEval_SaveThread();
 	aerospike_key_apply(self->as, &err, policy_p, &key, module, function, arglist, &result);
+	PyEval_RestoreThread(_save);
 
 	if ( err.code == AEROSPIKE_OK ) {
-		val_to_pyobject(&err, result, &py_result);
+		val_to_pyobject_owned(self, &err, result, NULL, &py_result);
 	}
 
 CLEANUP:
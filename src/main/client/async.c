@@ -0,0 +1,506 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include <aerospike/as_key.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_record.h>
+
+#include "async.h"
+#include "client.h"
+#include "conversions.h"
+#include "future.h"
+#include "policy.h"
+
+/*******************************************************************************
+ * COMPLETION
+ ******************************************************************************/
+
+/**
+ * Converts the results of the job, completes its future, and releases it.
+ * The udata of a job is a tuple of the future, followed by the Python objects
+ * which the converted arguments refer to.
+ */
+static void AerospikeClient_Async_Complete(async_job * job)
+{
+	PyObject * py_udata = (PyObject *) job->udata;
+	AerospikeFuture * future = (AerospikeFuture *) PyTuple_GetItem(py_udata, 0);
+
+	// The references of get and exists are the caller's key
+	PyObject * py_key = PyTuple_GetItem(py_udata, 1);
+
+	PyObject * py_result = NULL;
+	PyObject * py_err = NULL;
+
+	as_error err;
+	as_error_init(&err);
+	as_error_copy(&err, &job->err);
+
+	switch ( job->op ) {
+		case ASYNC_OP_GET: {
+			if ( err.code == AEROSPIKE_OK && future->client->bytes_view ) {
+				record_to_pyobject_view(future->client, &err, &job->result_rec, &job->key, py_key, &py_result);
+			}
+			else if ( err.code == AEROSPIKE_OK ) {
+				record_to_pyobject(future->client, &err, job->result_rec, &job->key, py_key, &py_result);
+			}
+			else if ( err.code == AEROSPIKE_ERR_RECORD_NOT_FOUND ) {
+				as_error_reset(&err);
+
+				PyObject * py_rec_key = NULL;
+				result_key_to_pyobject(future->client, &err, &job->key, py_key, &py_rec_key);
+
+				py_result = PyTuple_New(3);
+				PyTuple_SetItem(py_result, 0, py_rec_key);
+				PyTuple_SetItem(py_result, 1, Py_None);
+				PyTuple_SetItem(py_result, 2, Py_None);
+
+				Py_INCREF(Py_None);
+				Py_INCREF(Py_None);
+			}
+			break;
+		}
+		case ASYNC_OP_EXISTS: {
+			if ( err.code == AEROSPIKE_OK || err.code == AEROSPIKE_ERR_RECORD_NOT_FOUND ) {
+				PyObject * py_result_key = NULL;
+				PyObject * py_result_meta = Py_None;
+
+				if ( err.code == AEROSPIKE_OK ) {
+					metadata_to_pyobject(&err, job->result_rec, &py_result_meta);
+				}
+				else {
+					as_error_reset(&err);
+					Py_INCREF(py_result_meta);
+				}
+
+				result_key_to_pyobject(future->client, &err, &job->key, py_key, &py_result_key);
+
+				py_result = PyTuple_New(2);
+				PyTuple_SetItem(py_result, 0, py_result_key);
+				PyTuple_SetItem(py_result, 1, py_result_meta);
+			}
+			break;
+		}
+		case ASYNC_OP_PUT:
+		case ASYNC_OP_REMOVE: {
+			if ( err.code == AEROSPIKE_OK ) {
+				py_result = PyLong_FromLong(0);
+			}
+			break;
+		}
+		case ASYNC_OP_APPLY: {
+			if ( err.code == AEROSPIKE_OK ) {
+				val_to_pyobject_owned(future->client, &err, job->result_val, NULL, &py_result);
+			}
+			break;
+		}
+	}
+
+	if ( err.code != AEROSPIKE_OK ) {
+		Py_XDECREF(py_result);
+		py_result = NULL;
+		error_to_pyobject(&err, &py_err);
+	}
+
+	Py_INCREF(future);
+	AerospikeFuture_Complete(future, py_result, py_err);
+	Py_DECREF(future);
+
+	Py_DECREF(py_udata);
+	async_job_destroy(job);
+}
+
+static int AerospikeClient_Async_Complete_All(async_job * job)
+{
+	int count = 0;
+	while ( job != NULL ) {
+		async_job * next = job->next;
+		AerospikeClient_Async_Complete(job);
+		job = next;
+		count++;
+	}
+	return count;
+}
+
+int AerospikeClient_Async_Process(AerospikeClient * self)
+{
+	if ( self->async == NULL ) {
+		return 0;
+	}
+	return AerospikeClient_Async_Complete_All(async_engine_completed(self->async));
+}
+
+void AerospikeClient_Async_Close(AerospikeClient * self)
+{
+	if ( self->async == NULL ) {
+		return;
+	}
+
+	async_engine * engine = self->async;
+	self->async = NULL;
+
+	// Queued operations still execute, so wait for them without the GIL
+	PyThreadState * _save = PyEval_SaveThread();
+	async_job * done = async_engine_destroy(engine);
+	PyEval_RestoreThread(_save);
+
+	AerospikeClient_Async_Complete_All(done);
+}
+
+/*******************************************************************************
+ * SUBMISSION
+ ******************************************************************************/
+
+/**
+ * Hands the job to the engine, starting the engine if needed, and returns
+ * the future of the job. The references of the job are the Python objects
+ * the converted arguments point to, and are kept until the job completes.
+ * The submission fails if 'async_max_pending' operations are already queued.
+ * On error, the err argument is populated, the job is released and NULL is
+ * returned.
+ */
+static PyObject * AerospikeClient_Async_Submit(AerospikeClient * self, as_error * err, async_job * job, PyObject * py_refs)
+{
+	if ( self->as == NULL ) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "client is closed");
+		async_job_destroy(job);
+		return NULL;
+	}
+
+	if ( self->async == NULL ) {
+		self->async = async_engine_new(self->as, self->async_threads, self->async_max_pending);
+		if ( self->async == NULL ) {
+			as_error_update(err, AEROSPIKE_ERR_CLIENT, "failed to start the async engine");
+			async_job_destroy(job);
+			return NULL;
+		}
+	}
+
+	AerospikeFuture * future = AerospikeFuture_New(self);
+
+	PyObject * py_udata = PyTuple_Pack(2, (PyObject *) future, py_refs);
+	job->udata = py_udata;
+
+	if ( ! async_engine_submit(self->async, job) ) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "too many pending async operations");
+		Py_DECREF(py_udata);
+		Py_DECREF(future);
+		async_job_destroy(job);
+		return NULL;
+	}
+
+	return (PyObject *) future;
+}
+
+static PyObject * AerospikeClient_Async_Error(as_error * err)
+{
+	PyObject * py_err = NULL;
+	error_to_pyobject(err, &py_err);
+	PyErr_SetObject(PyExc_Exception, py_err);
+	return NULL;
+}
+
+/*******************************************************************************
+ * OPERATIONS
+ ******************************************************************************/
+
+PyObject * AerospikeClient_Get_Async(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Arguments
+	PyObject * py_key = NULL;
+	PyObject * py_policy = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"key", "policy", NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "O|O:get_async", kwlist,
+			&py_key, &py_policy) == false ) {
+		return NULL;
+	}
+
+	as_error err;
+	as_error_init(&err);
+
+	async_job * job = async_job_new(ASYNC_OP_GET);
+	as_policy_read * policy_p = NULL;
+
+	// Convert python key object to as_key
+	pyobject_to_key(&err, py_key, &job->key);
+	if ( err.code != AEROSPIKE_OK ) {
+		async_job_destroy(job);
+		return AerospikeClient_Async_Error(&err);
+	}
+
+	// Convert python policy object to as_policy_read
+	pyobject_to_policy_read(&err, py_policy, &job->policy.read, &policy_p);
+	if ( err.code != AEROSPIKE_OK ) {
+		async_job_destroy(job);
+		return AerospikeClient_Async_Error(&err);
+	}
+	job->policy_p = policy_p;
+
+	PyObject * py_future = AerospikeClient_Async_Submit(self, &err, job, py_key);
+	if ( py_future == NULL ) {
+		return AerospikeClient_Async_Error(&err);
+	}
+
+	return py_future;
+}
+
+PyObject * AerospikeClient_Put_Async(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Arguments
+	PyObject * py_key = NULL;
+	PyObject * py_bins = NULL;
+	PyObject * py_meta = NULL;
+	PyObject * py_policy = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"key", "record", "metadata", "policy", NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "OO|OO:put_async", kwlist,
+			&py_key, &py_bins, &py_meta, &py_policy) == false ) {
+		return NULL;
+	}
+
+	as_error err;
+	as_error_init(&err);
+
+	async_job * job = async_job_new(ASYNC_OP_PUT);
+	as_policy_write * policy_p = NULL;
+
+	// Convert python key object to as_key
+	pyobject_to_key(&err, py_key, &job->key);
+	if ( err.code != AEROSPIKE_OK ) {
+		async_job_destroy(job);
+		return AerospikeClient_Async_Error(&err);
+	}
+
+	// Convert python bins and metadata objects to as_record
+	pyobject_to_record(self, &err, py_bins, py_meta, &job->rec, &job->arena);
+	if ( err.code != AEROSPIKE_OK ) {
+		async_job_destroy(job);
+		return AerospikeClient_Async_Error(&err);
+	}
+	job->rec_initialized = true;
+
+	// Convert python policy object to as_policy_write
+	pyobject_to_policy_write(&err, py_policy, &job->policy.write, &policy_p);
+	if ( err.code != AEROSPIKE_OK ) {
+		async_job_destroy(job);
+		return AerospikeClient_Async_Error(&err);
+	}
+	job->policy_p = policy_p;
+
+	// The policy may override the compression of the client
+	pyobject_to_compression(&err, py_policy, &self->compression, &job->compression);
+	if ( err.code != AEROSPIKE_OK ) {
+		async_job_destroy(job);
+		return AerospikeClient_Async_Error(&err);
+	}
+
+	// The strings and buffers of the bins are held by the arena of the job
+	PyObject * py_refs = PyTuple_Pack(2, py_key, py_bins);
+	PyObject * py_future = AerospikeClient_Async_Submit(self, &err, job, py_refs);
+	Py_DECREF(py_refs);
+
+	if ( py_future == NULL ) {
+		return AerospikeClient_Async_Error(&err);
+	}
+
+	return py_future;
+}
+
+PyObject * AerospikeClient_Exists_Async(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Arguments
+	PyObject * py_key = NULL;
+	PyObject * py_policy = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"key", "policy", NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "O|O:exists_async", kwlist,
+			&py_key, &py_policy) == false ) {
+		return NULL;
+	}
+
+	as_error err;
+	as_error_init(&err);
+
+	async_job * job = async_job_new(ASYNC_OP_EXISTS);
+	as_policy_read * policy_p = NULL;
+
+	// Convert python key object to as_key
+	pyobject_to_key(&err, py_key, &job->key);
+	if ( err.code != AEROSPIKE_OK ) {
+		async_job_destroy(job);
+		return AerospikeClient_Async_Error(&err);
+	}
+
+	// Convert python policy object to as_policy_read
+	pyobject_to_policy_read(&err, py_policy, &job->policy.read, &policy_p);
+	if ( err.code != AEROSPIKE_OK ) {
+		async_job_destroy(job);
+		return AerospikeClient_Async_Error(&err);
+	}
+	job->policy_p = policy_p;
+
+	PyObject * py_future = AerospikeClient_Async_Submit(self, &err, job, py_key);
+	if ( py_future == NULL ) {
+		return AerospikeClient_Async_Error(&err);
+	}
+
+	return py_future;
+}
+
+PyObject * AerospikeClient_Remove_Async(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Arguments
+	PyObject * py_key = NULL;
+	PyObject * py_policy = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"key", "policy", NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "O|O:remove_async", kwlist,
+			&py_key, &py_policy) == false ) {
+		return NULL;
+	}
+
+	as_error err;
+	as_error_init(&err);
+
+	async_job * job = async_job_new(ASYNC_OP_REMOVE);
+	as_policy_remove * policy_p = NULL;
+
+	// Convert python key object to as_key
+	pyobject_to_key(&err, py_key, &job->key);
+	if ( err.code != AEROSPIKE_OK ) {
+		async_job_destroy(job);
+		return AerospikeClient_Async_Error(&err);
+	}
+
+	// Convert python policy object to as_policy_remove
+	pyobject_to_policy_remove(&err, py_policy, &job->policy.remove, &policy_p);
+	if ( err.code != AEROSPIKE_OK ) {
+		async_job_destroy(job);
+		return AerospikeClient_Async_Error(&err);
+	}
+	job->policy_p = policy_p;
+
+	PyObject * py_future = AerospikeClient_Async_Submit(self, &err, job, py_key);
+	if ( py_future == NULL ) {
+		return AerospikeClient_Async_Error(&err);
+	}
+
+	return py_future;
+}
+
+PyObject * AerospikeClient_Apply_Async(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Arguments
+	PyObject * py_key = NULL;
+	PyObject * py_module = NULL;
+	PyObject * py_function = NULL;
+	PyObject * py_arglist = NULL;
+	PyObject * py_policy = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"key", "module", "function", "args", "policy", NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "OOOO|O:apply_async", kwlist,
+			&py_key, &py_module, &py_function, &py_arglist, &py_policy) == false ) {
+		return NULL;
+	}
+
+	as_error err;
+	as_error_init(&err);
+
+	async_job * job = async_job_new(ASYNC_OP_APPLY);
+	as_policy_apply * policy_p = NULL;
+
+	if ( ! PyString_Check(py_module) || ! PyString_Check(py_function) ) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "udf module and function must be strings");
+		async_job_destroy(job);
+		return AerospikeClient_Async_Error(&err);
+	}
+
+	job->module = PyString_AsString(py_module);
+	job->function = PyString_AsString(py_function);
+
+	// Convert python key object to as_key
+	pyobject_to_key(&err, py_key, &job->key);
+	if ( err.code != AEROSPIKE_OK ) {
+		async_job_destroy(job);
+		return AerospikeClient_Async_Error(&err);
+	}
+
+	// Convert python list to as_list, in the arena of the job, which holds
+	// the strings and buffers of the arguments until the job is released
+	pyobject_to_list(self, &err, py_arglist, &job->arglist, &job->arena);
+	if ( err.code != AEROSPIKE_OK ) {
+		async_job_destroy(job);
+		return AerospikeClient_Async_Error(&err);
+	}
+
+	// Convert python policy object to as_policy_apply
+	pyobject_to_policy_apply(&err, py_policy, &job->policy.apply, &policy_p);
+	if ( err.code != AEROSPIKE_OK ) {
+		async_job_destroy(job);
+		return AerospikeClient_Async_Error(&err);
+	}
+	job->policy_p = policy_p;
+
+	PyObject * py_refs = PyTuple_Pack(4, py_key, py_module, py_function, py_arglist);
+	PyObject * py_future = AerospikeClient_Async_Submit(self, &err, job, py_refs);
+	Py_DECREF(py_refs);
+
+	if ( py_future == NULL ) {
+		return AerospikeClient_Async_Error(&err);
+	}
+
+	return py_future;
+}
+
+PyObject * AerospikeClient_Async_Fd(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	as_error err;
+	as_error_init(&err);
+
+	if ( self->async == NULL && self->as != NULL ) {
+		self->async = async_engine_new(self->as, self->async_threads, self->async_max_pending);
+	}
+
+	if ( self->async == NULL ) {
+		as_error_update(&err, AEROSPIKE_ERR_CLIENT, "the async engine is not available");
+		return AerospikeClient_Async_Error(&err);
+	}
+
+	return PyInt_FromLong(async_engine_fd(self->async));
+}
+
+PyObject * AerospikeClient_Async_Poll(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	return PyInt_FromLong(AerospikeClient_Async_Process(self));
+}
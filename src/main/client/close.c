@@ -25,6 +25,9 @@
 PyObject * AerospikeClient_Close(AerospikeClient * self, PyObject * args, PyObject * kwds)
 {
 	as_error err;
+
+	// Complete the outstanding async operations, before the cluster goes away
+	AerospikeClient_Async_Close(self);
 	
 	aerospike_close(self->as, &err);
 
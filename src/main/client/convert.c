@@ -0,0 +1,71 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include <aerospike/as_error.h>
+#include <aerospike/as_record.h>
+
+#include "arena.h"
+#include "client.h"
+#include "conversions.h"
+
+PyObject * AerospikeClient_Convert(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Arguments
+	PyObject * py_bins = NULL;
+	PyObject * py_meta = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"record", "metadata", NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "O|O:convert", kwlist,
+			&py_bins, &py_meta) == false ) {
+		return NULL;
+	}
+
+	// Aerospike Client Arguments
+	as_error err;
+	as_record rec;
+	arena arena;
+
+	// Initialize error
+	as_error_init(&err);
+
+	// The values of the record are allocated from the arena, as for put()
+	arena_init(&arena);
+
+	// Convert python bins and metadata objects to as_record
+	if ( pyobject_to_record(self, &err, py_bins, py_meta, &rec, &arena) == AEROSPIKE_OK ) {
+		as_record_destroy(&rec);
+	}
+
+	arena_destroy(&arena);
+
+	// If an error occurred, tell Python.
+	if ( err.code != AEROSPIKE_OK ) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyErr_SetObject(PyExc_Exception, py_err);
+		return NULL;
+	}
+
+	Py_INCREF(Py_None);
+	return Py_None;
+}
@@ -0,0 +1,88 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include <aerospike/as_key.h>
+#include <aerospike/as_error.h>
+
+#include "client.h"
+#include "conversions.h"
+
+PyObject * AerospikeClient_Digest(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Arguments
+	PyObject * py_ns = NULL;
+	PyObject * py_set = NULL;
+	PyObject * py_key = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"ns", "set", "key", NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "OOO:digest", kwlist, 
+			&py_ns, &py_set, &py_key) == false ) {
+		return NULL;
+	}
+
+	// Python Return Value
+	PyObject * py_digest = NULL;
+
+	// Aerospike Client Arguments
+	as_error err;
+	as_key key;
+
+	// Initialize error
+	as_error_init(&err);
+
+	if ( py_key == Py_None ) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "key is required");
+		goto CLEANUP;
+	}
+
+	// Convert python key to as_key
+	PyObject * py_keytuple = PyTuple_Pack(3, py_ns, py_set, py_key);
+	pyobject_to_key(&err, py_keytuple, &key);
+	Py_DECREF(py_keytuple);
+
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+
+	// Compute the RIPEMD-160 digest of the set and key
+	as_digest * digest = as_key_digest(&key);
+
+	if ( digest == NULL || ! digest->init ) {
+		as_error_update(&err, AEROSPIKE_ERR_CLIENT, "failed to compute the digest");
+	}
+	else {
+		py_digest = PyString_FromStringAndSize((char *) digest->value, AS_DIGEST_VALUE_SIZE);
+	}
+
+	as_key_destroy(&key);
+
+CLEANUP:
+
+	if ( err.code != AEROSPIKE_OK ) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyErr_SetObject(PyExc_Exception, py_err);
+		return NULL;
+	}
+
+	return py_digest;
+}
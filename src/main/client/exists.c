@@ -50,21 +50,23 @@ PyObject * AerospikeClient_Exists_Invoke(
 		goto CLEANUP;
 	}
 
-	// Convert python policy object to as_policy_exists
+	// Convert python policy object to as_policy_read
 	pyobject_to_policy_read(&err, py_policy, &policy, &policy_p);
 	if ( err.code != AEROSPIKE_OK ) {
 		goto CLEANUP;
 	}
 
-	// Invoke operation
+	// Invoke operation, without holding the GIL while waiting on the network
+	PyThreadState * _save = PyEval_SaveThread();
 	aerospike_key_exists(self->as, &err, policy_p, &key, &rec);
+	PyEval_RestoreThread(_save);
 
 	if ( err.code == AEROSPIKE_OK ) {
 
 		PyObject * py_result_key = NULL;
 		PyObject * py_result_meta = NULL;
 
-		key_to_pyobject(&err, &key, &py_result_key);
+		result_key_to_pyobject(self, &err, &key, py_key, &py_result_key);
 		metadata_to_pyobject(&err, rec, &py_result_meta);
 		
 		py_result = PyTuple_New(2);
@@ -77,7 +79,7 @@ PyObject * AerospikeClient_Exists_Invoke(
 		PyObject * py_result_key = NULL;
 		PyObject * py_result_meta = Py_None;
 
-		key_to_pyobject(&err, &key, &py_result_key);
+		result_key_to_pyobject(self, &err, &key, py_key, &py_result_key);
 		
 		py_result = PyTuple_New(2);
 		PyTuple_SetItem(py_result, 0, py_result_key);
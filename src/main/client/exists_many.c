@@ -0,0 +1,184 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include <aerospike/aerospike_batch.h>
+#include <aerospike/as_batch.h>
+#include <aerospike/as_key.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_record.h>
+
+#include "client.h"
+#include "conversions.h"
+#include "policy.h"
+
+// Struct for Python User-Data for the Callback
+typedef struct {
+	as_error error;
+	PyObject * py_keys;
+	PyObject * py_results;
+	as_batch * batch;
+} LocalData;
+
+static bool each_batch(const as_batch_read * results, uint32_t n, void * udata)
+{
+	// Extract callback user-data
+	LocalData * data = (LocalData *) udata;
+	as_error * err = &data->error;
+
+	// Lock Python State
+	PyGILState_STATE gstate;
+	gstate = PyGILState_Ensure();
+
+	for ( uint32_t i = 0; i < n; i++ ) {
+
+		// Results reference the keys of the batch, so we can find the input key
+		uint32_t index = (uint32_t) (results[i].key - as_batch_keyat(data->batch, 0));
+		PyObject * py_key = PySequence_Fast_GET_ITEM(data->py_keys, index);
+		PyObject * py_result = NULL;
+
+		if ( results[i].result == AEROSPIKE_OK ) {
+
+			PyObject * py_result_key = NULL;
+			PyObject * py_result_meta = NULL;
+
+			key_to_pyobject(err, results[i].key, &py_result_key);
+			metadata_to_pyobject(err, &results[i].record, &py_result_meta);
+
+			py_result = PyTuple_New(2);
+			PyTuple_SetItem(py_result, 0, py_result_key);
+			PyTuple_SetItem(py_result, 1, py_result_meta);
+		}
+		else if ( results[i].result == AEROSPIKE_ERR_RECORD_NOT_FOUND ) {
+			Py_INCREF(Py_None);
+			py_result = Py_None;
+		}
+		else {
+			as_error_update(err, results[i].result, "batch exists failed for key at index %u", index);
+		}
+
+		if ( err->code != AEROSPIKE_OK ) {
+			Py_XDECREF(py_result);
+			break;
+		}
+
+		PyDict_SetItem(data->py_results, py_key, py_result);
+		Py_DECREF(py_result);
+	}
+
+	// Release Python State
+	PyGILState_Release(gstate);
+
+	return err->code == AEROSPIKE_OK;
+}
+
+PyObject * AerospikeClient_Exists_Many(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Arguments
+	PyObject * py_keys = NULL;
+	PyObject * py_policy = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"keys", "policy", NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "O|O:exists_many", kwlist,
+			&py_keys, &py_policy) == false ) {
+		return NULL;
+	}
+
+	// Python Return Value
+	PyObject * py_results = NULL;
+	PyObject * py_keys_seq = NULL;
+
+	// Aerospike Client Arguments
+	as_error err;
+	as_policy_batch policy;
+	as_policy_batch * policy_p = NULL;
+	as_batch batch;
+	bool batch_initialized = false;
+
+	// Initialize error
+	as_error_init(&err);
+
+	py_keys_seq = PySequence_Fast(py_keys, "keys must be a list or tuple");
+	if ( ! py_keys_seq ) {
+		PyErr_Clear();
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "keys must be a list or tuple");
+		goto CLEANUP;
+	}
+
+	uint32_t n_keys = (uint32_t) PySequence_Fast_GET_SIZE(py_keys_seq);
+
+	// Convert python key objects to as_keys of the batch, all in one pass
+	as_batch_init(&batch, n_keys);
+	batch_initialized = true;
+
+	pyobject_to_batch(&err, py_keys_seq, &batch);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+
+	// Convert python policy object to as_policy_batch
+	pyobject_to_policy_batch(&err, py_policy, &policy, &policy_p);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+
+	py_results = PyDict_New();
+
+	if ( n_keys == 0 ) {
+		goto CLEANUP;
+	}
+
+	// Create and initialize callback user-data
+	LocalData data;
+	data.py_keys = py_keys_seq;
+	data.py_results = py_results;
+	data.batch = &batch;
+	as_error_init(&data.error);
+
+	// Invoke operation, without holding the GIL while waiting on the network.
+	// Only metadata is requested, so no bins are sent back. The callback 
+	// reacquires the GIL to convert the results.
+	PyThreadState * _save = PyEval_SaveThread();
+	aerospike_batch_exists(self->as, &err, policy_p, &batch, each_batch, &data);
+	PyEval_RestoreThread(_save);
+
+	if ( err.code == AEROSPIKE_OK && data.error.code != AEROSPIKE_OK ) {
+		as_error_copy(&err, &data.error);
+	}
+
+CLEANUP:
+
+	if ( batch_initialized ) {
+		as_batch_destroy(&batch);
+	}
+
+	Py_XDECREF(py_keys_seq);
+
+	if ( err.code != AEROSPIKE_OK ) {
+		Py_XDECREF(py_results);
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyErr_SetObject(PyExc_Exception, py_err);
+		return NULL;
+	}
+
+	return py_results;
+}
@@ -26,6 +26,7 @@
 #include "conversions.h"
 #include "key.h"
 #include "policy.h"
+#include "record.h"
 
 PyObject * AerospikeClient_Get_Invoke(
 	AerospikeClient * self, 
@@ -50,20 +51,27 @@ PyObject * AerospikeClient_Get_Invoke(
 		goto CLEANUP;
 	}
 
-	// Convert python policy object to as_policy_exists
+	// Convert python policy object to as_policy_read
 	pyobject_to_policy_read(&err, py_policy, &policy, &policy_p);
 	if ( err.code != AEROSPIKE_OK ) {
 		goto CLEANUP;
 	}
 
-	// Initialize record
-	as_record_init(rec, 0);
-
-	// Invoke operation
-	aerospike_key_get(self->as, &err, NULL, &key, &rec);
+	// Invoke operation, without holding the GIL while waiting on the network
+	PyThreadState * _save = PyEval_SaveThread();
+	aerospike_key_get(self->as, &err, policy_p, &key, &rec);
+	PyEval_RestoreThread(_save);
 
 	if ( err.code == AEROSPIKE_OK ) {
-		record_to_pyobject(&err, rec, &key, &py_rec);
+		if ( self->lazy_records ) {
+			py_rec = AerospikeRecord_New(&err, &rec, &key, py_key, self);
+		}
+		else if ( self->bytes_view ) {
+			record_to_pyobject_view(self, &err, &rec, &key, py_key, &py_rec);
+		}
+		else {
+			record_to_pyobject(self, &err, rec, &key, py_key, &py_rec);
+		}
 	}
 	else if ( err.code == AEROSPIKE_ERR_RECORD_NOT_FOUND ) {
 		as_error_reset(&err);
@@ -72,7 +80,7 @@ PyObject * AerospikeClient_Get_Invoke(
 		PyObject * py_rec_meta = Py_None;
 		PyObject * py_rec_bins = Py_None;
 
-		key_to_pyobject(&err, &key, &py_rec_key);
+		result_key_to_pyobject(self, &err, &key, py_key, &py_rec_key);
 		
 		py_rec = PyTuple_New(3);
 		PyTuple_SetItem(py_rec, 0, py_rec_key);
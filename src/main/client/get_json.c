@@ -0,0 +1,132 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include <aerospike/aerospike_key.h>
+#include <aerospike/as_key.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_record.h>
+
+#include "client.h"
+#include "conversions.h"
+#include "json.h"
+#include "key.h"
+#include "policy.h"
+
+PyObject * AerospikeClient_Get_Json(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Arguments
+	PyObject * py_key = NULL;
+	PyObject * py_bins = Py_None;
+	PyObject * py_policy = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"key", "bins", "policy", NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "O|OO:get_json", kwlist, 
+			&py_key, &py_bins, &py_policy) == false ) {
+		return NULL;
+	}
+
+	// Python Return Value
+	PyObject * py_json = NULL;
+	PyObject * py_bins_seq = NULL;
+
+	// Aerospike Client Arguments
+	as_error err;
+	as_policy_read policy;
+	as_policy_read * policy_p = NULL;
+	as_key key;
+	bool key_initialized = false;
+	as_record * rec = NULL;
+	const char ** bins = NULL;
+	uint32_t n_bins = 0;
+	char * json = NULL;
+	size_t json_size = 0;
+
+	// Initialize error
+	as_error_init(&err);
+
+	// Convert python key object to as_key
+	pyobject_to_key(&err, py_key, &key);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+	key_initialized = true;
+
+	// Convert python list of bin names to the projection
+	if ( py_bins != Py_None ) {
+		pyobject_to_bin_names(&err, py_bins, &py_bins_seq, &bins, &n_bins);
+		if ( err.code != AEROSPIKE_OK ) {
+			goto CLEANUP;
+		}
+	}
+
+	// Convert python policy object to as_policy_read
+	pyobject_to_policy_read(&err, py_policy, &policy, &policy_p);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+
+	// Invoke operation and encode the record, without holding the GIL
+	PyThreadState * _save = PyEval_SaveThread();
+	if ( bins != NULL ) {
+		aerospike_key_select(self->as, &err, policy_p, &key, bins, &rec);
+	}
+	else {
+		aerospike_key_get(self->as, &err, policy_p, &key, &rec);
+	}
+	if ( err.code == AEROSPIKE_OK ) {
+		json_encode_record(&err, rec, self->decompress, &json, &json_size);
+	}
+	PyEval_RestoreThread(_save);
+
+	if ( err.code == AEROSPIKE_OK ) {
+		py_json = PyString_FromStringAndSize(json, (Py_ssize_t) json_size);
+	}
+	else if ( err.code == AEROSPIKE_ERR_RECORD_NOT_FOUND ) {
+		as_error_reset(&err);
+		py_json = Py_None;
+		Py_INCREF(py_json);
+	}
+
+CLEANUP:
+
+	if ( rec != NULL ) {
+		as_record_destroy(rec);
+	}
+
+	if ( key_initialized ) {
+		as_key_destroy(&key);
+	}
+
+	free(json);
+	free(bins);
+	Py_XDECREF(py_bins_seq);
+
+	if ( err.code != AEROSPIKE_OK ) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyErr_SetObject(PyExc_Exception, py_err);
+		return NULL;
+	}
+	
+	return py_json;
+}
@@ -0,0 +1,213 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include <aerospike/aerospike_batch.h>
+#include <aerospike/as_batch.h>
+#include <aerospike/as_key.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_record.h>
+
+#include "client.h"
+#include "conversions.h"
+#include "policy.h"
+#include "record.h"
+
+// Struct for Python User-Data for the Callback
+typedef struct {
+	as_error error;
+	PyObject * py_keys;
+	PyObject * py_results;
+	as_batch * batch;
+	AerospikeClient * client;
+} LocalData;
+
+static bool each_batch(const as_batch_read * results, uint32_t n, void * udata)
+{
+	// Extract callback user-data
+	LocalData * data = (LocalData *) udata;
+	as_error * err = &data->error;
+
+	// Lock Python State
+	PyGILState_STATE gstate;
+	gstate = PyGILState_Ensure();
+
+	for ( uint32_t i = 0; i < n; i++ ) {
+
+		// Results reference the keys of the batch, so we can find the input key
+		uint32_t index = (uint32_t) (results[i].key - as_batch_keyat(data->batch, 0));
+		PyObject * py_key = PySequence_Fast_GET_ITEM(data->py_keys, index);
+		PyObject * py_rec = NULL;
+
+		if ( results[i].result == AEROSPIKE_OK && data->client->lazy_records ) {
+			py_rec = AerospikeRecord_Retain(err, &results[i].record, results[i].key, data->client);
+		}
+		else if ( results[i].result == AEROSPIKE_OK ) {
+			record_to_pyobject(data->client, err, &results[i].record, results[i].key, NULL, &py_rec);
+		}
+		else if ( results[i].result == AEROSPIKE_ERR_RECORD_NOT_FOUND ) {
+
+			PyObject * py_rec_key = NULL;
+			PyObject * py_rec_meta = Py_None;
+			PyObject * py_rec_bins = Py_None;
+
+			key_to_pyobject(err, results[i].key, &py_rec_key);
+
+			py_rec = PyTuple_New(3);
+			PyTuple_SetItem(py_rec, 0, py_rec_key);
+			PyTuple_SetItem(py_rec, 1, py_rec_meta);
+			PyTuple_SetItem(py_rec, 2, py_rec_bins);
+
+			Py_INCREF(py_rec_meta);
+			Py_INCREF(py_rec_bins);
+		}
+		else {
+			as_error_update(err, results[i].result, "batch read failed for key at index %u", index);
+		}
+
+		if ( err->code != AEROSPIKE_OK ) {
+			Py_XDECREF(py_rec);
+			break;
+		}
+
+		PyDict_SetItem(data->py_results, py_key, py_rec);
+		Py_DECREF(py_rec);
+	}
+
+	// Release Python State
+	PyGILState_Release(gstate);
+
+	return err->code == AEROSPIKE_OK;
+}
+
+PyObject * AerospikeClient_Get_Many(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Arguments
+	PyObject * py_keys = NULL;
+	PyObject * py_bins = NULL;
+	PyObject * py_policy = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"keys", "bins", "policy", NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "O|OO:get_many", kwlist,
+			&py_keys, &py_bins, &py_policy) == false ) {
+		return NULL;
+	}
+
+	// Python Return Value
+	PyObject * py_results = NULL;
+	PyObject * py_keys_seq = NULL;
+	PyObject * py_bins_seq = NULL;
+
+	// Aerospike Client Arguments
+	as_error err;
+	as_policy_batch policy;
+	as_policy_batch * policy_p = NULL;
+	as_batch batch;
+	bool batch_initialized = false;
+	const char ** bins = NULL;
+	uint32_t n_bins = 0;
+
+	// Initialize error
+	as_error_init(&err);
+
+	py_keys_seq = PySequence_Fast(py_keys, "keys must be a list or tuple");
+	if ( ! py_keys_seq ) {
+		PyErr_Clear();
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "keys must be a list or tuple");
+		goto CLEANUP;
+	}
+
+	uint32_t n_keys = (uint32_t) PySequence_Fast_GET_SIZE(py_keys_seq);
+
+	// Convert python key objects to as_keys of the batch, all in one pass
+	as_batch_init(&batch, n_keys);
+	batch_initialized = true;
+
+	pyobject_to_batch(&err, py_keys_seq, &batch);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+
+	// Convert python list of bin names to the projection
+	if ( py_bins && py_bins != Py_None ) {
+		pyobject_to_bin_names(&err, py_bins, &py_bins_seq, &bins, &n_bins);
+		if ( err.code != AEROSPIKE_OK ) {
+			goto CLEANUP;
+		}
+	}
+
+	// Convert python policy object to as_policy_batch
+	pyobject_to_policy_batch(&err, py_policy, &policy, &policy_p);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+
+	py_results = PyDict_New();
+
+	if ( n_keys == 0 ) {
+		goto CLEANUP;
+	}
+
+	// Create and initialize callback user-data
+	LocalData data;
+	data.py_keys = py_keys_seq;
+	data.py_results = py_results;
+	data.batch = &batch;
+	data.client = self;
+	as_error_init(&data.error);
+
+	// Invoke operation, without holding the GIL while waiting on the network.
+	// The callback reacquires it to convert the results.
+	PyThreadState * _save = PyEval_SaveThread();
+
+	if ( bins ) {
+		aerospike_batch_get_bins(self->as, &err, policy_p, &batch, bins, n_bins, each_batch, &data);
+	}
+	else {
+		aerospike_batch_get(self->as, &err, policy_p, &batch, each_batch, &data);
+	}
+
+	PyEval_RestoreThread(_save);
+
+	if ( err.code == AEROSPIKE_OK && data.error.code != AEROSPIKE_OK ) {
+		as_error_copy(&err, &data.error);
+	}
+
+CLEANUP:
+
+	if ( batch_initialized ) {
+		as_batch_destroy(&batch);
+	}
+
+	free(bins);
+	Py_XDECREF(py_bins_seq);
+	Py_XDECREF(py_keys_seq);
+
+	if ( err.code != AEROSPIKE_OK ) {
+		Py_XDECREF(py_results);
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyErr_SetObject(PyExc_Exception, py_err);
+		return NULL;
+	}
+
+	return py_results;
+}
@@ -0,0 +1,148 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include <aerospike/aerospike_key.h>
+#include <aerospike/as_key.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_operations.h>
+#include <aerospike/as_record.h>
+
+#include "client.h"
+#include "conversions.h"
+#include "policy.h"
+#include "record.h"
+
+PyObject * AerospikeClient_Operate(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Arguments
+	PyObject * py_key = NULL;
+	PyObject * py_ops = NULL;
+	PyObject * py_meta = NULL;
+	PyObject * py_policy = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"key", "list", "meta", "policy", NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "OO|OO:operate", kwlist, 
+			&py_key, &py_ops, &py_meta, &py_policy) == false ) {
+		return NULL;
+	}
+
+	// Python Return Value
+	PyObject * py_rec = NULL;
+
+	// Aerospike Client Arguments
+	as_error err;
+	as_policy_operate policy;
+	as_policy_operate * policy_p = NULL;
+	as_key key;
+	as_operations ops;
+	as_record * rec = NULL;
+	bool key_initialized = false;
+	bool ops_initialized = false;
+	arena arena;
+
+	// Initialize error
+	as_error_init(&err);
+
+	// The values of the operations are allocated from the arena
+	arena_init(&arena);
+
+	// Convert python key object to as_key
+	pyobject_to_key(&err, py_key, &key);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+	key_initialized = true;
+
+	// Convert python list of operations to as_operations
+	pyobject_to_operations(self, &err, py_ops, py_meta, &ops, &arena);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+	ops_initialized = true;
+
+	// Convert python policy object to as_policy_operate
+	pyobject_to_policy_operate(&err, py_policy, &policy, &policy_p);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+
+	// Invoke operation, without holding the GIL while waiting on the network
+	PyThreadState * _save = PyEval_SaveThread();
+	aerospike_key_operate(self->as, &err, policy_p, &key, &ops, &rec);
+	PyEval_RestoreThread(_save);
+
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+
+	if ( rec != NULL && self->lazy_records ) {
+		py_rec = AerospikeRecord_New(&err, &rec, &key, py_key, self);
+	}
+	else if ( rec != NULL && self->bytes_view ) {
+		record_to_pyobject_view(self, &err, &rec, &key, py_key, &py_rec);
+	}
+	else if ( rec != NULL ) {
+		record_to_pyobject(self, &err, rec, &key, py_key, &py_rec);
+	}
+	else {
+		// No read operations, so there are no bins to return
+		PyObject * py_rec_key = NULL;
+		PyObject * py_rec_meta = Py_None;
+		PyObject * py_rec_bins = Py_None;
+
+		result_key_to_pyobject(self, &err, &key, py_key, &py_rec_key);
+
+		py_rec = PyTuple_New(3);
+		PyTuple_SetItem(py_rec, 0, py_rec_key);
+		PyTuple_SetItem(py_rec, 1, py_rec_meta);
+		PyTuple_SetItem(py_rec, 2, py_rec_bins);
+
+		Py_INCREF(py_rec_meta);
+		Py_INCREF(py_rec_bins);
+	}
+
+CLEANUP:
+
+	if ( rec != NULL ) {
+		as_record_destroy(rec);
+	}
+
+	if ( ops_initialized ) {
+		as_operations_destroy(&ops);
+	}
+
+	arena_destroy(&arena);
+
+	if ( key_initialized ) {
+		as_key_destroy(&key);
+	}
+
+	if ( err.code != AEROSPIKE_OK ) {
+		Py_XDECREF(py_rec);
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyErr_SetObject(PyExc_Exception, py_err);
+		return NULL;
+	}
+
+	return py_rec;
+}
@@ -37,10 +37,16 @@ PyObject * AerospikeClient_Put_Invoke(
 	as_policy_write * policy_p = NULL;
 	as_key key;
 	as_record rec;
+	bool rec_initialized = false;
+	arena arena;
+	compression compression;
 	
 	// Initialize error
 	as_error_init(&err);
 
+	// The values of the record are allocated from the arena
+	arena_init(&arena);
+
 	// Convert python key object to as_key
 	pyobject_to_key(&err, py_key, &key);
 	if ( err.code != AEROSPIKE_OK ) {
@@ -48,10 +54,11 @@ PyObject * AerospikeClient_Put_Invoke(
 	}
 
 	// Convert python bins and metadata objects to as_record
-	pyobject_to_record(&err, py_bins, py_meta, &rec);
+	pyobject_to_record(self, &err, py_bins, py_meta, &rec, &arena);
 	if ( err.code != AEROSPIKE_OK ) {
 		goto CLEANUP;
 	}
+	rec_initialized = true;
 
 	// Convert python policy object to as_policy_write
 	pyobject_to_policy_write(&err, py_policy, &policy, &policy_p);
@@ -59,12 +66,26 @@ PyObject * AerospikeClient_Put_Invoke(
 		goto CLEANUP;
 	}
 
-	// Invoke operation
-	aerospike_key_put(self->as, &err, policy_p, &key, &rec);
+	// The policy may override the compression of the client
+	pyobject_to_compression(&err, py_policy, &self->compression, &compression);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+
+	// Compress and invoke operation, without holding the GIL
+	PyThreadState * _save = PyEval_SaveThread();
+	if ( compression_compress_record(&err, &compression, &rec, &arena) == AEROSPIKE_OK ) {
+		aerospike_key_put(self->as, &err, policy_p, &key, &rec);
+	}
+	PyEval_RestoreThread(_save);
 	
 CLEANUP:
 
-	as_record_destroy(&rec);
+	if ( rec_initialized ) {
+		as_record_destroy(&rec);
+	}
+
+	arena_destroy(&arena);
 
 	// If an error occurred, tell Python.
 	if ( err.code != AEROSPIKE_OK ) {
@@ -0,0 +1,381 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <aerospike/aerospike_key.h>
+#include <aerospike/as_key.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_record.h>
+#include <aerospike/as_string.h>
+
+#include "client.h"
+#include "conversions.h"
+#include "policy.h"
+
+#define PUT_MANY_CONCURRENCY_DEFAULT 8
+#define PUT_MANY_CONCURRENCY_MAX 256
+
+/**
+ * A converted item, owned by the queue while its put is in flight.
+ * The Python item is referenced, so the key stays alive until the put
+ * completes. The strings and buffers the record points to are held by the
+ * arena, as the bins dict may be changed meanwhile.
+ */
+typedef struct put_item_s {
+	struct put_item_s * next;
+	PyObject * py_item;
+	PyObject * py_key;
+	as_key key;
+	as_record rec;
+	as_error err;
+	arena arena;
+} put_item;
+
+/**
+ * The queue shared by the calling thread and the worker threads.
+ * Workers take items from `pending`, and hand them back through `done`.
+ * `inflight` counts the items in either list, or being written, and is
+ * bounded by `window`.
+ */
+typedef struct {
+	aerospike * as;
+	as_policy_write * policy;
+	compression compression;
+	pthread_mutex_t lock;
+	pthread_cond_t work;
+	pthread_cond_t space;
+	put_item * pending_head;
+	put_item * pending_tail;
+	put_item * done;
+	uint32_t inflight;
+	uint32_t window;
+	bool closed;
+} put_queue;
+
+static void * put_worker(void * udata)
+{
+	put_queue * queue = (put_queue *) udata;
+
+	while ( true ) {
+
+		pthread_mutex_lock(&queue->lock);
+
+		while ( queue->pending_head == NULL && ! queue->closed ) {
+			pthread_cond_wait(&queue->work, &queue->lock);
+		}
+
+		put_item * item = queue->pending_head;
+
+		if ( item == NULL ) {
+			pthread_mutex_unlock(&queue->lock);
+			break;
+		}
+
+		queue->pending_head = item->next;
+		if ( queue->pending_head == NULL ) {
+			queue->pending_tail = NULL;
+		}
+
+		pthread_mutex_unlock(&queue->lock);
+
+		// Compress and write the record. The GIL is not held by this thread.
+		if ( compression_compress_record(&item->err, &queue->compression, &item->rec, &item->arena) == AEROSPIKE_OK ) {
+			aerospike_key_put(queue->as, &item->err, queue->policy, &item->key, &item->rec);
+		}
+
+		pthread_mutex_lock(&queue->lock);
+		item->next = queue->done;
+		queue->done = item;
+		queue->inflight--;
+		pthread_cond_signal(&queue->space);
+		pthread_mutex_unlock(&queue->lock);
+	}
+
+	return NULL;
+}
+
+/**
+ * Releases completed items, appending a (key, error) tuple to the failures
+ * for each item which could not be written. Requires the GIL.
+ */
+static void put_items_release(put_item * item, PyObject * py_failures)
+{
+	while ( item != NULL ) {
+		put_item * next = item->next;
+
+		if ( item->err.code != AEROSPIKE_OK ) {
+			PyObject * py_err = NULL;
+			error_to_pyobject(&item->err, &py_err);
+			PyObject * py_failure = PyTuple_Pack(2, item->py_key, py_err);
+			PyList_Append(py_failures, py_failure);
+			Py_DECREF(py_failure);
+			Py_DECREF(py_err);
+		}
+
+		as_record_destroy(&item->rec);
+		arena_destroy(&item->arena);
+		as_key_destroy(&item->key);
+		Py_DECREF(item->py_item);
+		free(item);
+
+		item = next;
+	}
+}
+
+/**
+ * Converts a (key, bins) or (key, bins, meta) item into a put_item.
+ * On error, the err argument is populated and NULL is returned.
+ */
+static put_item * put_item_new(AerospikeClient * self, as_error * err, PyObject * py_item)
+{
+	as_error_reset(err);
+
+	if ( ! PyTuple_Check(py_item) || PyTuple_Size(py_item) < 2 || PyTuple_Size(py_item) > 3 ) {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "item must be a (key, bins) or (key, bins, meta) tuple");
+		return NULL;
+	}
+
+	PyObject * py_key = PyTuple_GetItem(py_item, 0);
+	PyObject * py_bins = PyTuple_GetItem(py_item, 1);
+	PyObject * py_meta = PyTuple_Size(py_item) == 3 ? PyTuple_GetItem(py_item, 2) : NULL;
+
+	if ( ! PyDict_Check(py_bins) ) {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "bins must be a dict");
+		return NULL;
+	}
+
+	put_item * item = (put_item *) calloc(1, sizeof(put_item));
+	arena_init(&item->arena);
+
+	pyobject_to_key(err, py_key, &item->key);
+	if ( err->code != AEROSPIKE_OK ) {
+		free(item);
+		return NULL;
+	}
+
+	// The namespace and set are copied into the key, but a string key points
+	// into the caller's str. Holding the item does not hold the str of a dict
+	// key, which the generator may replace before the worker puts the record,
+	// so the key owns a copy of it.
+	as_string * key_str = (as_string *) item->key.valuep;
+	if ( key_str && as_val_type((as_val *) key_str) == AS_STRING && ! key_str->free ) {
+		key_str->value = strdup(key_str->value);
+		key_str->free = true;
+	}
+
+	pyobject_to_record(self, err, py_bins, py_meta, &item->rec, &item->arena);
+	if ( err->code != AEROSPIKE_OK ) {
+		as_key_destroy(&item->key);
+		arena_destroy(&item->arena);
+		free(item);
+		return NULL;
+	}
+
+	as_error_init(&item->err);
+
+	Py_INCREF(py_item);
+	item->py_item = py_item;
+	item->py_key = py_key;
+
+	return item;
+}
+
+PyObject * AerospikeClient_Put_Many(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Arguments
+	PyObject * py_items = NULL;
+	PyObject * py_policy = NULL;
+	int concurrency = PUT_MANY_CONCURRENCY_DEFAULT;
+	int max_inflight = 0;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"items", "concurrency", "max_inflight", "policy", NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "O|iiO:put_many", kwlist,
+			&py_items, &concurrency, &max_inflight, &py_policy) == false ) {
+		return NULL;
+	}
+
+	// Python Return Value
+	PyObject * py_failures = NULL;
+	PyObject * py_iter = NULL;
+
+	// Aerospike Client Arguments
+	as_error err;
+	as_policy_write policy;
+	as_policy_write * policy_p = NULL;
+
+	// Worker Threads
+	put_queue queue;
+	pthread_t workers[PUT_MANY_CONCURRENCY_MAX];
+	int nworkers = 0;
+
+	// Initialize error
+	as_error_init(&err);
+
+	if ( concurrency < 1 || concurrency > PUT_MANY_CONCURRENCY_MAX ) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "concurrency must be between 1 and %d", PUT_MANY_CONCURRENCY_MAX);
+		goto CLEANUP;
+	}
+
+	if ( max_inflight <= 0 ) {
+		max_inflight = concurrency * 4;
+	}
+	else if ( max_inflight < concurrency ) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "max_inflight must not be less than concurrency");
+		goto CLEANUP;
+	}
+
+	// Convert python policy object to as_policy_write
+	pyobject_to_policy_write(&err, py_policy, &policy, &policy_p);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+
+	// The policy may override the compression of the client
+	compression compression;
+	pyobject_to_compression(&err, py_policy, &self->compression, &compression);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+
+	py_iter = PyObject_GetIter(py_items);
+	if ( ! py_iter ) {
+		PyErr_Clear();
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "items must be iterable");
+		goto CLEANUP;
+	}
+
+	py_failures = PyList_New(0);
+
+	// Initialize the queue and start the workers
+	memset(&queue, 0, sizeof(put_queue));
+	queue.as = self->as;
+	queue.policy = policy_p;
+	queue.compression = compression;
+	queue.window = (uint32_t) max_inflight;
+	pthread_mutex_init(&queue.lock, NULL);
+	pthread_cond_init(&queue.work, NULL);
+	pthread_cond_init(&queue.space, NULL);
+
+	for ( ; nworkers < concurrency; nworkers++ ) {
+		if ( pthread_create(&workers[nworkers], NULL, put_worker, &queue) != 0 ) {
+			break;
+		}
+	}
+
+	if ( nworkers == 0 ) {
+		as_error_update(&err, AEROSPIKE_ERR_CLIENT, "failed to start worker threads");
+	}
+
+	PyObject * py_item = NULL;
+
+	while ( err.code == AEROSPIKE_OK && (py_item = PyIter_Next(py_iter)) != NULL ) {
+
+		// Convert the item, while holding the GIL
+		as_error item_err;
+		put_item * item = put_item_new(self, &item_err, py_item);
+
+		if ( item == NULL ) {
+			PyObject * py_err = NULL;
+			error_to_pyobject(&item_err, &py_err);
+			PyObject * py_failure = PyTuple_Pack(2,
+				PyTuple_Check(py_item) && PyTuple_Size(py_item) > 0 ? PyTuple_GetItem(py_item, 0) : py_item,
+				py_err);
+			PyList_Append(py_failures, py_failure);
+			Py_DECREF(py_failure);
+			Py_DECREF(py_err);
+			Py_DECREF(py_item);
+			continue;
+		}
+
+		Py_DECREF(py_item);
+
+		// Wait for room in the window, then hand the item to the workers
+		put_item * done = NULL;
+
+		PyThreadState * _save = PyEval_SaveThread();
+		pthread_mutex_lock(&queue.lock);
+
+		while ( queue.inflight >= queue.window ) {
+			pthread_cond_wait(&queue.space, &queue.lock);
+		}
+
+		if ( queue.pending_tail ) {
+			queue.pending_tail->next = item;
+		}
+		else {
+			queue.pending_head = item;
+		}
+		queue.pending_tail = item;
+		queue.inflight++;
+
+		done = queue.done;
+		queue.done = NULL;
+
+		pthread_cond_signal(&queue.work);
+		pthread_mutex_unlock(&queue.lock);
+		PyEval_RestoreThread(_save);
+
+		put_items_release(done, py_failures);
+	}
+
+	// Let the workers drain the queue, then stop them
+	PyThreadState * _save = PyEval_SaveThread();
+
+	pthread_mutex_lock(&queue.lock);
+	queue.closed = true;
+	pthread_cond_broadcast(&queue.work);
+	pthread_mutex_unlock(&queue.lock);
+
+	for ( int i = 0; i < nworkers; i++ ) {
+		pthread_join(workers[i], NULL);
+	}
+
+	PyEval_RestoreThread(_save);
+
+	put_items_release(queue.done, py_failures);
+
+	pthread_cond_destroy(&queue.space);
+	pthread_cond_destroy(&queue.work);
+	pthread_mutex_destroy(&queue.lock);
+
+	// The iterator raised an exception, so propagate it
+	if ( PyErr_Occurred() ) {
+		Py_DECREF(py_failures);
+		Py_DECREF(py_iter);
+		return NULL;
+	}
+
+CLEANUP:
+
+	Py_XDECREF(py_iter);
+
+	if ( err.code != AEROSPIKE_OK ) {
+		Py_XDECREF(py_failures);
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyErr_SetObject(PyExc_Exception, py_err);
+		return NULL;
+	}
+
+	return py_failures;
+}
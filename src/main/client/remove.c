@@ -47,14 +47,16 @@ PyObject * AerospikeClient_Remove_Invoke(
 		goto CLEANUP;
 	}
 
-	// Convert python policy object to as_policy_exists
+	// Convert python policy object to as_policy_remove
 	pyobject_to_policy_remove(&err, py_policy, &policy, &policy_p);
 	if ( err.code != AEROSPIKE_OK ) {
 		goto CLEANUP;
 	}
 
-	// Invoke operation
+	// Invoke operation, without holding the GIL while waiting on the network
+	PyThreadState * _save = PyEval_SaveThread();
 	aerospike_key_remove(self->as, &err, policy_p, &key);
+	PyEval_RestoreThread(_save);
 
 CLEANUP:
 	
@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include <aerospike/aerospike_key.h>
+#include <aerospike/as_key.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_record.h>
+
+#include "client.h"
+#include "conversions.h"
+#include "key.h"
+#include "policy.h"
+#include "record.h"
+
+PyObject * AerospikeClient_Select_Invoke(
+	AerospikeClient * self, 
+	PyObject * py_key, PyObject * py_bins, PyObject * py_policy)
+{
+	// Python Return Value
+	PyObject * py_rec = NULL;
+	PyObject * py_bins_seq = NULL;
+
+	// Aerospike Client Arguments
+	as_error err;
+	as_policy_read policy;
+	as_policy_read * policy_p = NULL;
+	as_key key;
+	bool key_initialized = false;
+	as_record * rec = NULL;
+	const char ** bins = NULL;
+	uint32_t n_bins = 0;
+
+	// Initialize error
+	as_error_init(&err);
+
+	// Convert python key object to as_key
+	pyobject_to_key(&err, py_key, &key);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+	key_initialized = true;
+
+	// Convert python list of bin names to the projection
+	pyobject_to_bin_names(&err, py_bins, &py_bins_seq, &bins, &n_bins);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+
+	// Convert python policy object to as_policy_read
+	pyobject_to_policy_read(&err, py_policy, &policy, &policy_p);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+
+	// Invoke operation, without holding the GIL while waiting on the network
+	PyThreadState * _save = PyEval_SaveThread();
+	aerospike_key_select(self->as, &err, policy_p, &key, bins, &rec);
+	PyEval_RestoreThread(_save);
+
+	if ( err.code == AEROSPIKE_OK ) {
+		if ( self->lazy_records ) {
+			py_rec = AerospikeRecord_New(&err, &rec, &key, py_key, self);
+		}
+		else if ( self->bytes_view ) {
+			record_to_pyobject_view(self, &err, &rec, &key, py_key, &py_rec);
+		}
+		else {
+			record_to_pyobject(self, &err, rec, &key, py_key, &py_rec);
+		}
+	}
+	else if ( err.code == AEROSPIKE_ERR_RECORD_NOT_FOUND ) {
+		as_error_reset(&err);
+
+		PyObject * py_rec_key = NULL;
+		PyObject * py_rec_meta = Py_None;
+		PyObject * py_rec_bins = Py_None;
+
+		result_key_to_pyobject(self, &err, &key, py_key, &py_rec_key);
+		
+		py_rec = PyTuple_New(3);
+		PyTuple_SetItem(py_rec, 0, py_rec_key);
+		PyTuple_SetItem(py_rec, 1, py_rec_meta);
+		PyTuple_SetItem(py_rec, 2, py_rec_bins);
+
+		Py_INCREF(py_rec_meta);
+		Py_INCREF(py_rec_bins);
+	}
+
+CLEANUP:
+
+	if ( rec != NULL ) {
+		as_record_destroy(rec);
+	}
+
+	if ( key_initialized ) {
+		as_key_destroy(&key);
+	}
+
+	free(bins);
+	Py_XDECREF(py_bins_seq);
+
+	if ( err.code != AEROSPIKE_OK ) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyErr_SetObject(PyExc_Exception, py_err);
+		return NULL;
+	}
+	
+	return py_rec;
+}
+
+PyObject * AerospikeClient_Select(AerospikeClient * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Arguments
+	PyObject * py_key = NULL;
+	PyObject * py_bins = NULL;
+	PyObject * py_policy = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"key", "bins", "policy", NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "OO|O:select", kwlist, 
+			&py_key, &py_bins, &py_policy) == false ) {
+		return NULL;
+	}
+
+	// Invoke Operation
+	return AerospikeClient_Select_Invoke(self, py_key, py_bins, py_policy);
+}
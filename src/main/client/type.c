@@ -24,6 +24,8 @@
 #include <aerospike/as_policy.h>
 
 #include "client.h"
+#include "conversions.h"
+#include "policy.h"
 
 /*******************************************************************************
  * PYTHON TYPE METHODS
@@ -45,6 +47,12 @@ static PyMethodDef AerospikeClient_Type_Methods[] = {
 	{"get",		(PyCFunction) AerospikeClient_Get,		METH_VARARGS | METH_KEYWORDS, 
 				"Read a record from the database."},
 
+	{"select",	(PyCFunction) AerospikeClient_Select,	METH_VARARGS | METH_KEYWORDS, 
+				"Read specific bins of a record from the database."},
+
+	{"get_json",	(PyCFunction) AerospikeClient_Get_Json,	METH_VARARGS | METH_KEYWORDS, 
+				"Read a record from the database, as the JSON of its bins."},
+
 	{"put",		(PyCFunction) AerospikeClient_Put,		METH_VARARGS | METH_KEYWORDS, 
 				"Write a record into the database."},
 
@@ -54,6 +62,48 @@ static PyMethodDef AerospikeClient_Type_Methods[] = {
 	{"apply",	(PyCFunction) AerospikeClient_Apply,	METH_VARARGS | METH_KEYWORDS, 
 				"Apply a UDF on a record in the database."},
 
+	{"operate",	(PyCFunction) AerospikeClient_Operate,	METH_VARARGS | METH_KEYWORDS, 
+				"Perform multiple operations on a record in the database."},
+
+	// BATCH OPERATIONS
+	{"get_many",	(PyCFunction) AerospikeClient_Get_Many,	METH_VARARGS | METH_KEYWORDS, 
+				"Read multiple records from the database in a batch."},
+
+	{"exists_many",	(PyCFunction) AerospikeClient_Exists_Many,	METH_VARARGS | METH_KEYWORDS, 
+				"Check the existence of multiple records in the database in a batch."},
+
+	{"put_many",	(PyCFunction) AerospikeClient_Put_Many,	METH_VARARGS | METH_KEYWORDS, 
+				"Write multiple records into the database, using parallel writers."},
+
+	// ASYNC OPERATIONS
+	{"get_async",		(PyCFunction) AerospikeClient_Get_Async,		METH_VARARGS | METH_KEYWORDS, 
+				"Read a record from the database, returning a Future."},
+
+	{"put_async",		(PyCFunction) AerospikeClient_Put_Async,		METH_VARARGS | METH_KEYWORDS, 
+				"Write a record into the database, returning a Future."},
+
+	{"exists_async",	(PyCFunction) AerospikeClient_Exists_Async,		METH_VARARGS | METH_KEYWORDS, 
+				"Check the existence of a record in the database, returning a Future."},
+
+	{"remove_async",	(PyCFunction) AerospikeClient_Remove_Async,		METH_VARARGS | METH_KEYWORDS, 
+				"Remove a record from the database, returning a Future."},
+
+	{"apply_async",		(PyCFunction) AerospikeClient_Apply_Async,		METH_VARARGS | METH_KEYWORDS, 
+				"Apply a UDF on a record in the database, returning a Future."},
+
+	{"async_fd",		(PyCFunction) AerospikeClient_Async_Fd,			METH_VARARGS | METH_KEYWORDS, 
+				"File descriptor signaled when async operations complete."},
+
+	{"async_poll",		(PyCFunction) AerospikeClient_Async_Poll,		METH_VARARGS | METH_KEYWORDS, 
+				"Complete the futures of the finished async operations."},
+
+    // DIGEST
+    {"digest",	(PyCFunction) AerospikeClient_Digest,	METH_VARARGS | METH_KEYWORDS, 
+    			"Compute the digest of a key, for addressing records by (ns, set, None, digest)."},
+
+    {"convert",	(PyCFunction) AerospikeClient_Convert,	METH_VARARGS | METH_KEYWORDS, 
+    			"Convert a record as put() does, without sending it."},
+
     // Deprecated key-based API
     {"key",		(PyCFunction) AerospikeClient_Key,		METH_VARARGS | METH_KEYWORDS, 
     			"**[DEPRECATED]** Create a new Key object for performing key operations."},
@@ -65,6 +115,10 @@ static PyMethodDef AerospikeClient_Type_Methods[] = {
     // SCAN OPERATIONS
     {"scan",	(PyCFunction) AerospikeClient_Scan,		METH_VARARGS | METH_KEYWORDS, 
     			"Create a new Scan object for performing scans."},
+
+    // SCHEMA OPERATIONS
+    {"schema",	(PyCFunction) AerospikeClient_Schema,	METH_VARARGS | METH_KEYWORDS, 
+    			"Create a new Schema object for the records of a set with fixed bins."},
 			
     // INFO OPERATIONS
 	{"info",	(PyCFunction) AerospikeClient_Info,		METH_VARARGS | METH_KEYWORDS, 
@@ -175,6 +229,68 @@ static int AerospikeClient_Type_Init(AerospikeClient * self, PyObject * args, Py
     }
 
     
+    self->async = NULL;
+    self->async_threads = 16;
+
+    PyObject * py_async_threads = PyDict_GetItemString(py_config, "async_threads");
+    if ( py_async_threads && PyInt_Check(py_async_threads) && PyInt_AsLong(py_async_threads) > 0 ) {
+        self->async_threads = (uint32_t) PyInt_AsLong(py_async_threads);
+    }
+
+    self->async_max_pending = 4096;
+
+    PyObject * py_async_max_pending = PyDict_GetItemString(py_config, "async_max_pending");
+    if ( py_async_max_pending && PyInt_Check(py_async_max_pending) && PyInt_AsLong(py_async_max_pending) >= 0 ) {
+        self->async_max_pending = (uint32_t) PyInt_AsLong(py_async_max_pending);
+    }
+
+    PyObject * py_bytes_view = PyDict_GetItemString(py_config, "bytes_view");
+    self->bytes_view = py_bytes_view && PyObject_IsTrue(py_bytes_view) == 1;
+
+    self->bin_names = intern_table_new();
+
+    PyObject * py_lazy_records = PyDict_GetItemString(py_config, "lazy_records");
+    self->lazy_records = py_lazy_records && PyObject_IsTrue(py_lazy_records) == 1;
+
+    // Single-key calls return the caller's key, without the digest, if enabled
+    PyObject * py_reuse_keys = PyDict_GetItemString(py_config, "reuse_keys");
+    self->reuse_keys = py_reuse_keys && PyObject_IsTrue(py_reuse_keys) == 1;
+
+    // Large string and bytes bins are compressed on write
+    compression compression_defaults = { 0, COMPRESSION_LEVEL_DEFAULT };
+    as_error compression_err;
+    as_error_init(&compression_err);
+    if ( pyobject_to_compression(&compression_err, py_config, &compression_defaults, &self->compression) != AEROSPIKE_OK ) {
+        self->compression = compression_defaults;
+        PyObject * py_err = NULL;
+        error_to_pyobject(&compression_err, &py_err);
+        PyErr_SetObject(PyExc_Exception, py_err);
+        return -1;
+    }
+
+    // Bytes bins are only inflated by clients which expect compressed bins,
+    // so that raw bytes which happen to start with the header are left alone
+    PyObject * py_decompress = PyDict_GetItemString(py_config, "decompress");
+    if ( py_decompress ) {
+        self->decompress = PyObject_IsTrue(py_decompress) == 1;
+    }
+    else {
+        self->decompress = self->compression.threshold > 0;
+    }
+
+    // Values of unsupported types are stored as serialized bytes
+    as_error serializer_err;
+    serializer_init(&self->serializer, &serializer_err, PyDict_GetItemString(py_config, "serializer"));
+    if ( serializer_err.code == AEROSPIKE_OK ) {
+        serializer_init(&self->deserializer, &serializer_err, PyDict_GetItemString(py_config, "deserializer"));
+    }
+    if ( serializer_err.code != AEROSPIKE_OK ) {
+        PyObject * py_err = NULL;
+        error_to_pyobject(&serializer_err, &py_err);
+        PyErr_SetObject(PyExc_Exception, py_err);
+        return -1;
+    }
+
     as_policies_init(&config.policies);
 
 	self->as = aerospike_new(&config);
@@ -182,8 +298,12 @@ static int AerospikeClient_Type_Init(AerospikeClient * self, PyObject * args, Py
     return 0;
 }
 
-static void AerospikeClient_Type_Dealloc(PyObject * self)
+static void AerospikeClient_Type_Dealloc(AerospikeClient * self)
 {
+    AerospikeClient_Async_Close(self);
+    intern_table_destroy(self->bin_names);
+    serializer_destroy(&self->serializer);
+    serializer_destroy(&self->deserializer);
     self->ob_type->tp_free((PyObject *) self);
 }
 
@@ -0,0 +1,169 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <zlib.h>
+
+#include <aerospike/as_bytes.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_record.h>
+#include <aerospike/as_string.h>
+#include <aerospike/as_val.h>
+
+#include "arena.h"
+#include "compression.h"
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+as_status compression_compress_record(as_error * err, const compression * c, as_record * rec, arena * arena)
+{
+	as_error_reset(err);
+
+	if ( c->threshold == 0 ) {
+		return err->code;
+	}
+
+	for ( uint16_t i = 0; i < rec->bins.size; i++ ) {
+		as_bin * bin = &rec->bins.entries[i];
+		as_val * val = (as_val *) bin->valuep;
+
+		if ( val == NULL ) {
+			continue;
+		}
+
+		const uint8_t * data = NULL;
+		uint32_t size = 0;
+		as_bytes_type bytes_type = AS_BYTES_BLOB;
+
+		switch ( as_val_type(val) ) {
+			case AS_STRING: {
+				as_string * s = as_string_fromval(val);
+				data = (const uint8_t *) as_string_get(s);
+				size = data ? (uint32_t) as_string_len(s) : 0;
+				break;
+			}
+			case AS_BYTES: {
+				as_bytes * b = as_bytes_fromval(val);
+				data = as_bytes_get(b);
+				size = as_bytes_size(b);
+				bytes_type = as_bytes_get_type(b);
+				break;
+			}
+			default: {
+				break;
+			}
+		}
+
+		if ( data == NULL || size < c->threshold ) {
+			continue;
+		}
+
+		uLongf bound = compressBound(size);
+		uint8_t * out = (uint8_t *) arena_alloc(arena, COMPRESSION_HEADER_SIZE + bound);
+		if ( out == NULL ) {
+			return as_error_update(err, AEROSPIKE_ERR_CLIENT, "failed to allocate the compressed value of bin %s", bin->name);
+		}
+
+		uLongf out_size = bound;
+		if ( compress2(out + COMPRESSION_HEADER_SIZE, &out_size, data, size, c->level) != Z_OK ) {
+			return as_error_update(err, AEROSPIKE_ERR_CLIENT, "failed to compress bin %s", bin->name);
+		}
+
+		// Incompressible values are written as they are
+		if ( COMPRESSION_HEADER_SIZE + out_size >= size ) {
+			continue;
+		}
+
+		memcpy(out, COMPRESSION_MAGIC, COMPRESSION_MAGIC_SIZE);
+		out[4] = (uint8_t) as_val_type(val);
+		out[5] = (uint8_t) bytes_type;
+		out[6] = (uint8_t) (size >> 24);
+		out[7] = (uint8_t) (size >> 16);
+		out[8] = (uint8_t) (size >> 8);
+		out[9] = (uint8_t) size;
+
+		as_bytes * bytes = (as_bytes *) arena_alloc(arena, sizeof(as_bytes));
+		if ( bytes == NULL ) {
+			return as_error_update(err, AEROSPIKE_ERR_CLIENT, "failed to allocate the compressed value of bin %s", bin->name);
+		}
+		as_bytes_init_wrap(bytes, out, (uint32_t) (COMPRESSION_HEADER_SIZE + out_size), false);
+		as_bytes_set_type(bytes, AS_BYTES_BLOB);
+
+		// Releases the data of values which own it, such as serialized values
+		as_val_destroy(val);
+		bin->valuep = (as_bin_value *) bytes;
+	}
+
+	return err->code;
+}
+
+static uint32_t compression_original_size(const uint8_t * p)
+{
+	return ((uint32_t) p[6] << 24) | ((uint32_t) p[7] << 16) | ((uint32_t) p[8] << 8) | p[9];
+}
+
+bool compression_is_compressed(const as_bytes * bytes)
+{
+	const uint8_t * p = as_bytes_get(bytes);
+	uint32_t n = as_bytes_size(bytes);
+
+	if ( as_bytes_get_type(bytes) != AS_BYTES_BLOB || n < COMPRESSION_HEADER_SIZE || memcmp(p, COMPRESSION_MAGIC, COMPRESSION_MAGIC_SIZE) != 0 ) {
+		return false;
+	}
+
+	if ( p[4] != AS_STRING && p[4] != AS_BYTES ) {
+		return false;
+	}
+
+	// A corrupt or forged size must not drive the allocation
+	uint64_t limit = (uint64_t) (n - COMPRESSION_HEADER_SIZE) * COMPRESSION_RATIO_MAX;
+	return compression_original_size(p) <= limit;
+}
+
+bool compression_inflate(const as_bytes * bytes, as_val_t * val_type, as_bytes_type * bytes_type, uint8_t ** data, uint32_t * size)
+{
+	if ( ! compression_is_compressed(bytes) ) {
+		return false;
+	}
+
+	const uint8_t * p = as_bytes_get(bytes);
+	uint32_t n = as_bytes_size(bytes);
+	uint32_t original = compression_original_size(p);
+
+	uint8_t * out = (uint8_t *) malloc(original ? original : 1);
+	if ( out == NULL ) {
+		return false;
+	}
+
+	uLongf out_size = original;
+	if ( uncompress(out, &out_size, p + COMPRESSION_HEADER_SIZE, n - COMPRESSION_HEADER_SIZE) != Z_OK || out_size != original ) {
+		free(out);
+		return false;
+	}
+
+	*val_type = (as_val_t) p[4];
+	*bytes_type = (as_bytes_type) p[5];
+	*data = out;
+	*size = original;
+
+	return true;
+}
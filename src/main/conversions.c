@@ -17,17 +17,27 @@
 #include <Python.h>
 #include <stdbool.h>
 
+#include <aerospike/as_batch.h>
 #include <aerospike/as_key.h>
 #include <aerospike/as_error.h>
 #include <aerospike/as_record.h>
 
+#include <aerospike/as_double.h>
+#include <aerospike/as_nil.h>
 #include <aerospike/as_list.h>
 #include <aerospike/as_arraylist.h>
 #include <aerospike/as_map.h>
 #include <aerospike/as_hashmap.h>
+#include <aerospike/as_operations.h>
 #include <aerospike/as_policy.h>
 
+#include "arena.h"
+#include "bytes_view.h"
+#include "compression.h"
+#include "intern.h"
 #include "key.h"
+#include "packer.h"
+#include "serializer.h"
 #include "conversions.h"
 
 #define PY_KEYT_NAMESPACE 0
@@ -41,34 +51,56 @@
 #define PY_EXCEPTION_LINE 3
 
 
-as_status pyobject_to_list(as_error * err, PyObject * py_list, as_list ** list)
+/**
+ * Converts a list or tuple into an as_list.
+ */
+as_status pyobject_to_list(AerospikeClient * self, as_error * err, PyObject * py_list, as_list ** list, arena * arena)
 {
 	as_error_reset(err);
 
-	Py_ssize_t size = PyList_Size(py_list);
+	if ( ! PyList_Check(py_list) && ! PyTuple_Check(py_list) ) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "value must be a list or tuple");
+	}
+
+	Py_ssize_t size = PySequence_Fast_GET_SIZE(py_list);
 
-	if ( *list == NULL ) {
+	if ( *list == NULL && arena ) {
+		// Like as_arraylist_inita(), with the elements in the arena
+		as_arraylist * arraylist = (as_arraylist *) arena_alloc(arena, sizeof(as_arraylist));
+		as_val ** elements = (as_val **) arena_alloc(arena, sizeof(as_val *) * size);
+		if ( arraylist == NULL || elements == NULL ) {
+			return as_error_update(err, AEROSPIKE_ERR_CLIENT, "failed to allocate a list");
+		}
+		as_arraylist_init(arraylist, 0, 0);
+		arraylist->free = false;
+		arraylist->capacity = (uint32_t) size;
+		arraylist->size = 0;
+		arraylist->elements = elements;
+		*list = (as_list *) arraylist;
+	}
+	else if ( *list == NULL ) {
 		*list = (as_list *) as_arraylist_new((uint32_t) size, 0);
 	}
 
-	for ( int i = 0; i < size; i++ ) {
-		 PyObject * py_val = PyList_GetItem(py_list, i);
-		 as_val * val = NULL;
-		 pyobject_to_val(err, py_val, &val);
-		 if ( err->code != AEROSPIKE_OK ) {
-		 	break;
-		 }
-		 as_list_append(*list, val);
+	for ( Py_ssize_t i = 0; i < size; i++ ) {
+		PyObject * py_val = PySequence_Fast_GET_ITEM(py_list, i);
+		as_val * val = NULL;
+		pyobject_to_val(self, err, py_val, &val, arena);
+		if ( err->code != AEROSPIKE_OK ) {
+			break;
+		}
+		as_list_append(*list, val);
 	}
 
 	if ( err->code != AEROSPIKE_OK ) {
 		as_list_destroy(*list);
+		*list = NULL;
 	}
 
 	return err->code;
 }
 
-as_status pyobject_to_map(as_error * err, PyObject * py_dict, as_map ** map)
+as_status pyobject_to_map(AerospikeClient * self, as_error * err, PyObject * py_dict, as_map ** map, arena * arena)
 {
 	as_error_reset(err);
 
@@ -77,19 +109,27 @@ as_status pyobject_to_map(as_error * err, PyObject * py_dict, as_map ** map)
 	Py_ssize_t pos = 0;
 	Py_ssize_t size = PyDict_Size(py_dict);
 
-	if ( *map == NULL ) {
+	if ( *map == NULL && arena ) {
+		as_hashmap * hashmap = (as_hashmap *) arena_alloc(arena, sizeof(as_hashmap));
+		if ( hashmap == NULL ) {
+			return as_error_update(err, AEROSPIKE_ERR_CLIENT, "failed to allocate a map");
+		}
+		*map = (as_map *) as_hashmap_init(hashmap, (uint32_t) size);
+	}
+	else if ( *map == NULL ) {
 		*map = (as_map *) as_hashmap_new((uint32_t) size);
 	}
 
 	while (PyDict_Next(py_dict, &pos, &py_key, &py_val)) {
 		as_val * key = NULL;
 		as_val * val = NULL;
-		pyobject_to_val(err, py_key, &key);
+		pyobject_to_val(self, err, py_key, &key, arena);
 		if ( err->code != AEROSPIKE_OK ) {
 			break;
 		}
-		pyobject_to_val(err, py_val, &val);
+		pyobject_to_val(self, err, py_val, &val, arena);
 		if ( err->code != AEROSPIKE_OK ) {
+			as_val_destroy(key);
 			break;
 		}
 		as_map_set(*map, key, val);
@@ -97,12 +137,280 @@ as_status pyobject_to_map(as_error * err, PyObject * py_dict, as_map ** map)
 
 	if ( err->code != AEROSPIKE_OK ) {
 		as_map_destroy(*map);
+		*map = NULL;
 	}	
 
 	return err->code;
 }
 
-as_status pyobject_to_val(as_error * err, PyObject * py_obj, as_val ** val)
+/*******************************************************************************
+ * VALUE CONVERTERS
+ ******************************************************************************/
+
+/**
+ * The values are allocated from the arena, when there is one, and from the
+ * heap otherwise. ARENA_NEW() populates the error and returns NULL when the
+ * arena is out of memory.
+ */
+#define ARENA_NEW(__arena, __err, __type) \
+	((__type *) arena_new((__arena), (__err), sizeof(__type)))
+
+static void * arena_new(arena * arena, as_error * err, size_t size)
+{
+	void * p = arena_alloc(arena, size);
+	if ( p == NULL ) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "failed to allocate a value");
+	}
+	return p;
+}
+
+static as_status integer_to_val(as_error * err, int64_t i, as_val ** val, arena * arena)
+{
+	if ( ! arena ) {
+		*val = (as_val *) as_integer_new(i);
+		return err->code;
+	}
+	as_integer * integer = ARENA_NEW(arena, err, as_integer);
+	if ( integer ) {
+		*val = (as_val *) as_integer_init(integer, i);
+	}
+	return err->code;
+}
+
+static as_status pyint_to_val(AerospikeClient * self, as_error * err, PyObject * py_obj, as_val ** val, arena * arena)
+{
+	return integer_to_val(err, (int64_t) PyInt_AsLong(py_obj), val, arena);
+}
+
+static as_status pylong_to_val(AerospikeClient * self, as_error * err, PyObject * py_obj, as_val ** val, arena * arena)
+{
+	int64_t l = (int64_t) PyLong_AsLongLong(py_obj);
+	if ( l == -1 && PyErr_Occurred() ) {
+		PyErr_Clear();
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "integer value exceeds 64 bits");
+	}
+	return integer_to_val(err, l, val, arena);
+}
+
+static as_status pybool_to_val(AerospikeClient * self, as_error * err, PyObject * py_obj, as_val ** val, arena * arena)
+{
+	return integer_to_val(err, py_obj == Py_True ? 1 : 0, val, arena);
+}
+
+static as_status pyfloat_to_val(AerospikeClient * self, as_error * err, PyObject * py_obj, as_val ** val, arena * arena)
+{
+	double d = PyFloat_AsDouble(py_obj);
+	if ( ! arena ) {
+		*val = (as_val *) as_double_new(d);
+		return err->code;
+	}
+	as_double * dbl = ARENA_NEW(arena, err, as_double);
+	if ( dbl ) {
+		*val = (as_val *) as_double_init(dbl, d);
+	}
+	return err->code;
+}
+
+static as_status pynone_to_val(AerospikeClient * self, as_error * err, PyObject * py_obj, as_val ** val, arena * arena)
+{
+	*val = (as_val *) &as_nil;
+	return err->code;
+}
+
+static void pybuffer_release(void * data)
+{
+	PyBuffer_Release((Py_buffer *) data);
+}
+
+static void pyobject_release(void * data)
+{
+	Py_DECREF((PyObject *) data);
+}
+
+/**
+ * The string points into the str object. With an arena, the str is held
+ * until the arena is destroyed, as the caller may drop it meanwhile, such as
+ * by replacing the value in the bins dict while the request is in flight.
+ */
+static as_status pystring_to_val(AerospikeClient * self, as_error * err, PyObject * py_obj, as_val ** val, arena * arena)
+{
+	char * s = PyString_AsString(py_obj);
+	if ( ! arena ) {
+		*val = (as_val *) as_string_new(s, false);
+		return err->code;
+	}
+	as_string * string = ARENA_NEW(arena, err, as_string);
+	if ( string == NULL ) {
+		return err->code;
+	}
+	if ( ! arena_defer(arena, pyobject_release, py_obj) ) {
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "failed to allocate a value");
+	}
+	Py_INCREF(py_obj);
+	*val = (as_val *) as_string_init(string, s, false);
+	return err->code;
+}
+
+/**
+ * Converts an object exporting the buffer protocol into bytes. With an
+ * arena, the bytes point into the object's buffer export, which is held
+ * until the arena is destroyed; old-style buffers cannot be held, so their
+ * data is copied into the arena. Heap values have nothing to hold the
+ * buffer, so the data is copied.
+ */
+static as_status pybuffer_to_val(AerospikeClient * self, as_error * err, PyObject * py_obj, as_val ** val, arena * arena)
+{
+	Py_buffer local;
+	Py_buffer * view = arena ? ARENA_NEW(arena, err, Py_buffer) : &local;
+	const void * data = NULL;
+	Py_ssize_t size = 0;
+
+	if ( view == NULL ) {
+		return err->code;
+	}
+
+	if ( PyObject_CheckBuffer(py_obj) ) {
+		if ( PyObject_GetBuffer(py_obj, view, PyBUF_SIMPLE) != 0 ) {
+			PyErr_Clear();
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "value of type %s does not export a contiguous buffer", Py_TYPE(py_obj)->tp_name);
+		}
+		data = view->buf;
+		size = view->len;
+	}
+	else {
+		// Old-style buffers, such as array.array, mmap and buffer, are not
+		// locked against resizing or closing, so they are always copied
+		if ( PyObject_AsReadBuffer(py_obj, &data, &size) != 0 ) {
+			PyErr_Clear();
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "value of type %s does not export a readable buffer", Py_TYPE(py_obj)->tp_name);
+		}
+		view = NULL;
+	}
+
+	if ( size > UINT32_MAX ) {
+		if ( view ) {
+			PyBuffer_Release(view);
+		}
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "buffer value exceeds 4 GiB");
+	}
+
+	if ( arena ) {
+		as_bytes * bytes = ARENA_NEW(arena, err, as_bytes);
+		uint8_t * bytes_data = (uint8_t *) data;
+		if ( bytes && ! view ) {
+			bytes_data = (uint8_t *) arena_alloc(arena, size);
+			if ( bytes_data ) {
+				memcpy(bytes_data, data, size);
+			}
+		}
+		bool pinned = bytes && bytes_data && ( ! view || arena_defer(arena, pybuffer_release, view) );
+		if ( ! pinned ) {
+			if ( view ) {
+				PyBuffer_Release(view);
+			}
+			return as_error_update(err, AEROSPIKE_ERR_CLIENT, "failed to allocate a value");
+		}
+		*val = (as_val *) as_bytes_init_wrap(bytes, bytes_data, (uint32_t) size, false);
+	}
+	else {
+		uint8_t * copy = (uint8_t *) malloc(size ? size : 1);
+		memcpy(copy, data, size);
+		if ( view ) {
+			PyBuffer_Release(view);
+		}
+		*val = (as_val *) as_bytes_new_wrap(copy, (uint32_t) size, true);
+	}
+
+	return err->code;
+}
+
+/**
+ * With an arena, the bytes hold an export of the bytearray's buffer, which
+ * also keeps the bytearray from being resized while the request is in flight.
+ */
+static as_status pybytearray_to_val(AerospikeClient * self, as_error * err, PyObject * py_obj, as_val ** val, arena * arena)
+{
+	if ( arena ) {
+		return pybuffer_to_val(self, err, py_obj, val, arena);
+	}
+
+	uint8_t * b = (uint8_t *) PyByteArray_AsString(py_obj);
+	uint32_t z = (uint32_t) PyByteArray_Size(py_obj);
+	*val = (as_val *) as_bytes_new_wrap(b, z, false);
+	return err->code;
+}
+
+static as_status pysequence_to_val(AerospikeClient * self, as_error * err, PyObject * py_obj, as_val ** val, arena * arena)
+{
+	as_list * list = NULL;
+	pyobject_to_list(self, err, py_obj, &list, arena);
+	*val = (as_val *) list;
+	return err->code;
+}
+
+static as_status pydict_to_val(AerospikeClient * self, as_error * err, PyObject * py_obj, as_val ** val, arena * arena)
+{
+	as_map * map = NULL;
+	pyobject_to_map(self, err, py_obj, &map, arena);
+	*val = (as_val *) map;
+	return err->code;
+}
+
+/**
+ * Serializes a value of a type without a converter, with the serializer of
+ * the client. The bytes own the serialized buffer.
+ */
+static as_status pyserialized_to_val(AerospikeClient * self, as_error * err, PyObject * py_obj, as_val ** val, arena * arena)
+{
+	uint8_t * data = NULL;
+	uint32_t size = 0;
+	if ( serializer_dump(&self->serializer, err, py_obj, &data, &size) != AEROSPIKE_OK ) {
+		return err->code;
+	}
+	as_bytes * bytes = arena ? ARENA_NEW(arena, err, as_bytes) : NULL;
+	if ( arena && bytes == NULL ) {
+		free(data);
+		return err->code;
+	}
+	bytes = arena ? as_bytes_init_wrap(bytes, data, size, true) : as_bytes_new_wrap(data, size, true);
+	as_bytes_set_type(bytes, AS_BYTES_PYTHON);
+	*val = (as_val *) bytes;
+	return err->code;
+}
+
+/**
+ * The converters, by type. The exact type of a value is looked up first, in
+ * the order of the table, so the most common types come first. Subclasses
+ * fall back to the first type they derive from, so bool precedes int.
+ */
+static const struct {
+	PyTypeObject * type;
+	pyobject_to_val_fn convert;
+} pyobject_to_val_table[] = {
+	{ &PyInt_Type,			pyint_to_val },
+	{ &PyString_Type,		pystring_to_val },
+	{ &PyFloat_Type,		pyfloat_to_val },
+	{ &PyDict_Type,			pydict_to_val },
+	{ &PyList_Type,			pysequence_to_val },
+	{ &PyBool_Type,			pybool_to_val },
+	{ &PyLong_Type,			pylong_to_val },
+	{ &PyByteArray_Type,	pybytearray_to_val },
+	{ &PyTuple_Type,		pysequence_to_val },
+	{ &PyMemoryView_Type,	pybuffer_to_val },
+	{ NULL,					NULL }
+};
+
+pyobject_to_val_fn pyobject_to_val_converter(PyTypeObject * type)
+{
+	for ( int i = 0; pyobject_to_val_table[i].type; i++ ) {
+		if ( pyobject_to_val_table[i].type == type ) {
+			return pyobject_to_val_table[i].convert;
+		}
+	}
+	return NULL;
+}
+
+as_status pyobject_to_val(AerospikeClient * self, as_error * err, PyObject * py_obj, as_val ** val, arena * arena)
 {
 	as_error_reset(err);
 
@@ -110,49 +418,79 @@ as_status pyobject_to_val(as_error * err, PyObject * py_obj, as_val ** val)
 		// this should never happen, but if it did...
 		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "value is null");
 	}
-	else if ( PyInt_Check(py_obj) ) {
-		int64_t i = (int64_t) PyInt_AsLong(py_obj);
-		*val = (as_val *) as_integer_new(i);
+
+	if ( py_obj == Py_None ) {
+		return pynone_to_val(self, err, py_obj, val, arena);
 	}
-	else if ( PyLong_Check(py_obj) ) {
-		int64_t l = (int64_t) PyLong_AsLongLong(py_obj);
-		*val = (as_val *) as_integer_new(l);
+
+	PyTypeObject * type = Py_TYPE(py_obj);
+
+	for ( int i = 0; pyobject_to_val_table[i].type; i++ ) {
+		if ( pyobject_to_val_table[i].type == type ) {
+			return pyobject_to_val_table[i].convert(self, err, py_obj, val, arena);
+		}
 	}
-	else if ( PyString_Check(py_obj) ) {
-		char * s = PyString_AsString(py_obj);
-		*val = (as_val *) as_string_new(s, false);
+
+	for ( int i = 0; pyobject_to_val_table[i].type; i++ ) {
+		if ( PyType_IsSubtype(type, pyobject_to_val_table[i].type) ) {
+			return pyobject_to_val_table[i].convert(self, err, py_obj, val, arena);
+		}
 	}
-	else if ( PyByteArray_Check(py_obj) ) {
-		uint8_t * b = (uint8_t *) PyByteArray_AsString(py_obj);
-		uint32_t z = (uint32_t) PyByteArray_Size(py_obj);
-		*val = (as_val *) as_bytes_new_wrap(b, z, false);
+
+	// Any other binary data, such as array.array, mmap or numpy arrays, is
+	// written as bytes. Unicode exports its internal encoding, so it is not.
+	if ( ! PyUnicode_Check(py_obj) && (PyObject_CheckBuffer(py_obj) || PyObject_CheckReadBuffer(py_obj)) ) {
+		return pybuffer_to_val(self, err, py_obj, val, arena);
 	}
-	else if ( PyList_Check(py_obj) ) {
-		as_list * list = NULL;
-		pyobject_to_list(err, py_obj, &list);
-		if ( err->code == AEROSPIKE_OK ) {
-			*val = (as_val *) list;
-		}
+
+	if ( self && self->serializer.type != SERIALIZER_NONE ) {
+		return pyserialized_to_val(self, err, py_obj, val, arena);
+	}
+
+	return as_error_update(err, AEROSPIKE_ERR_PARAM, "value of type %s is not a supported type.", type->tp_name);
+}
+
+/**
+ * Sets the ttl and generation of a record from a metadata dict, if one is
+ * given.
+ */
+as_status pyobject_to_metadata(as_error * err, PyObject * py_meta, as_record * rec)
+{
+	if ( ! py_meta || ! PyDict_Check(py_meta) ) {
+		return err->code;
 	}
-	else if ( PyDict_Check(py_obj) ) {
-		as_map * map = NULL;
-		pyobject_to_map(err, py_obj, &map);
-		if ( err->code == AEROSPIKE_OK ) {
-			*val = (as_val *) map;
+
+	PyObject * py_gen = PyDict_GetItemString(py_meta, "gen");
+	PyObject * py_ttl = PyDict_GetItemString(py_meta, "ttl");
+
+	if( py_ttl != NULL ){
+		if ( PyInt_Check(py_ttl) ) {
+			rec->ttl = (uint32_t) PyInt_AsLong(py_ttl);
+		}
+		else if ( PyLong_Check(py_ttl) ) {
+			rec->ttl = (uint32_t) PyLong_AsLongLong(py_ttl);
 		}
 	}
-	else {
-		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "value is not a supported type.");
+
+	if( py_gen != NULL ){
+		if ( PyInt_Check(py_gen) ) {
+			rec->gen = (uint16_t) PyInt_AsLong(py_gen);
+		}
+		else if ( PyLong_Check(py_gen) ) {
+			rec->gen = (uint16_t) PyLong_AsLongLong(py_gen);
+		}
 	}
 
 	return err->code;
 }
 
 /**
- * Converts a PyObject into an as_record.
- * Returns AEROSPIKE_OK on success. On error, the err argument is populated.
+ * Converts a PyObject into an as_record. A bin with the value None is removed
+ * from the record in the database.
+ * Returns AEROSPIKE_OK on success. On error, the err argument is populated,
+ * and the record is destroyed.
  */
-as_status pyobject_to_record(as_error * err, PyObject * py_rec, PyObject * py_meta, as_record * rec)
+as_status pyobject_to_record(AerospikeClient * self, as_error * err, PyObject * py_rec, PyObject * py_meta, as_record * rec, arena * arena)
 {
 	as_error_reset(err);
 
@@ -160,90 +498,225 @@ as_status pyobject_to_record(as_error * err, PyObject * py_rec, PyObject * py_me
 		// this should never happen, but if it did...
 		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "record is null");
 	}
-	else if ( PyDict_Check(py_rec) ) {
-		PyObject *key = NULL, *value = NULL;
-		Py_ssize_t pos = 0;
-		Py_ssize_t size = PyDict_Size(py_rec);
+	else if ( ! PyDict_Check(py_rec) ) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "record must be a dict");
+	}
 
-		as_record_init(rec, size);
+	PyObject *key = NULL, *value = NULL;
+	Py_ssize_t pos = 0;
+	Py_ssize_t size = PyDict_Size(py_rec);
 
-		while (PyDict_Next(py_rec, &pos, &key, &value)) {
-			if ( ! PyString_Check(key) ) {
-				return as_error_update(err, AEROSPIKE_ERR_CLIENT, "A bin name must be a string.");
-			}
+	as_record_init(rec, size);
 
-			char * name = PyString_AsString(key);
+	while (PyDict_Next(py_rec, &pos, &key, &value)) {
+		if ( ! PyString_Check(key) ) {
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "A bin name must be a string.");
+			break;
+		}
 
-			if ( !value ) {
-				// this should never happen, but if it did...
-				return as_error_update(err, AEROSPIKE_ERR_CLIENT, "record is null");
-			}
-			else if ( PyInt_Check(value) ) {
-				int64_t val = (int64_t) PyInt_AsLong(value);
-				as_record_set_int64(rec, name, val);
-			}
-			else if ( PyLong_Check(value) ) {
-				int64_t val = (int64_t) PyLong_AsLongLong(value);
-				as_record_set_int64(rec, name, val);
-			}
-			else if ( PyString_Check(value) ) {
-				char * val = PyString_AsString(value);
-				as_record_set_strp(rec, name, val, false);
+		char * name = PyString_AsString(key);
+
+		if ( value == Py_None ) {
+			as_record_set_nil(rec, name);
+			continue;
+		}
+
+		as_val * val = NULL;
+		pyobject_to_val(self, err, value, &val, arena);
+		if ( err->code != AEROSPIKE_OK ) {
+			break;
+		}
+
+		as_record_set(rec, name, (as_bin_value *) val);
+	}
+
+	if ( err->code == AEROSPIKE_OK ) {
+		pyobject_to_metadata(err, py_meta, rec);
+	}
+
+	if ( err->code != AEROSPIKE_OK ) {
+		as_record_destroy(rec);
+	}
+
+	return err->code;
+}
+
+as_status pyobject_to_bin_names(as_error * err, PyObject * py_bins, PyObject ** py_seq, const char *** bins, uint32_t * n_bins)
+{
+	as_error_reset(err);
+
+	*py_seq = PySequence_Fast(py_bins, "bins must be a list or tuple");
+	if ( ! *py_seq ) {
+		PyErr_Clear();
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "bins must be a list or tuple");
+	}
+
+	uint32_t size = (uint32_t) PySequence_Fast_GET_SIZE(*py_seq);
+
+	*bins = (const char **) malloc(sizeof(char *) * (size + 1));
+	*n_bins = size;
+
+	for ( uint32_t i = 0; i < size; i++ ) {
+		PyObject * py_bin = PySequence_Fast_GET_ITEM(*py_seq, i);
+		if ( ! PyString_Check(py_bin) ) {
+			(*bins)[i] = NULL;
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "A bin name must be a string.");
+		}
+		(*bins)[i] = PyString_AsString(py_bin);
+	}
+	(*bins)[size] = NULL;
+
+	return err->code;
+}
+
+/**
+ * Converts a list of operation dicts into as_operations. Each operation is a
+ * dict of the operator ("op"), the bin name ("bin") and the value ("val"):
+ *
+ *		{"op": aerospike.OPERATOR_INCR, "bin": "count", "val": 1}
+ *
+ * The values are allocated from the arena, which holds the Python objects
+ * they point into, so an arena is required.
+ *
+ * Returns AEROSPIKE_OK on success. On error, the err argument is populated,
+ * and the operations are destroyed.
+ */
+as_status pyobject_to_operations(AerospikeClient * self, as_error * err, PyObject * py_ops, PyObject * py_meta, as_operations * ops, arena * arena)
+{
+	as_error_reset(err);
+
+	if ( ! arena ) {
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "operations require an arena");
+	}
+
+	if ( ! py_ops || ! PyList_Check(py_ops) ) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "operations must be a list");
+	}
+
+	Py_ssize_t size = PyList_Size(py_ops);
+
+	as_operations_init(ops, (uint16_t) size);
+
+	for ( Py_ssize_t i = 0; i < size && err->code == AEROSPIKE_OK; i++ ) {
+		PyObject * py_op = PyList_GetItem(py_ops, i);
+
+		if ( ! PyDict_Check(py_op) ) {
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "an operation must be a dict");
+			break;
+		}
+
+		PyObject * py_operator = PyDict_GetItemString(py_op, "op");
+		PyObject * py_bin = PyDict_GetItemString(py_op, "bin");
+		PyObject * py_val = PyDict_GetItemString(py_op, "val");
+
+		if ( ! py_operator || ! PyInt_Check(py_operator) ) {
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "an operation requires an operator (op)");
+			break;
+		}
+
+		long op = PyInt_AsLong(py_operator);
+
+		if ( op == AS_OPERATOR_TOUCH ) {
+			as_operations_add_touch(ops);
+			continue;
+		}
+
+		if ( ! py_bin || ! PyString_Check(py_bin) ) {
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "A bin name must be a string.");
+			break;
+		}
+
+		char * bin = PyString_AsString(py_bin);
+
+		if ( op != AS_OPERATOR_READ && ! py_val ) {
+			as_error_update(err, AEROSPIKE_ERR_PARAM, "operation on bin %s requires a value (val)", bin);
+			break;
+		}
+
+		switch ( op ) {
+			case AS_OPERATOR_READ: {
+				as_operations_add_read(ops, bin);
+				break;
 			}
-			else if ( PyByteArray_Check(value) ) {
-				uint8_t * val = (uint8_t *) PyByteArray_AsString(value);
-				uint32_t sz = (uint32_t) PyByteArray_Size(value);
-				as_record_set_rawp(rec, name, val, sz, false);
+			case AS_OPERATOR_WRITE: {
+				as_val * val = NULL;
+				pyobject_to_val(self, err, py_val, &val, arena);
+				if ( err->code == AEROSPIKE_OK ) {
+					as_operations_add_write(ops, bin, (as_bin_value *) val);
+				}
+				break;
 			}
-			else if ( PyList_Check(value) ) {
-				// as_list
-				as_list * list = NULL;
-				pyobject_to_list(err, value, &list);
-				if ( err->code != AEROSPIKE_OK ) {
-					break;
+			case AS_OPERATOR_INCR: {
+				if ( PyInt_Check(py_val) ) {
+					as_operations_add_incr(ops, bin, (int64_t) PyInt_AsLong(py_val));
 				}
-				as_record_set_list(rec, name, list);
+				else if ( PyLong_Check(py_val) ) {
+					as_operations_add_incr(ops, bin, (int64_t) PyLong_AsLongLong(py_val));
+				}
+				else {
+					as_error_update(err, AEROSPIKE_ERR_PARAM, "increment of bin %s requires an integer", bin);
+				}
+				break;
 			}
-			else if ( PyDict_Check(value) ) {
-				// as_map
-				as_map * map = NULL;
-				pyobject_to_map(err, value, &map);
+			case AS_OPERATOR_APPEND:
+			case AS_OPERATOR_PREPEND: {
+				// The arena holds the str, or an export of the bytearray,
+				// while the operation is sent without the GIL
+				bool append = op == AS_OPERATOR_APPEND;
+				as_val * val = NULL;
+				if ( PyString_Check(py_val) ) {
+					pystring_to_val(self, err, py_val, &val, arena);
+				}
+				else if ( PyByteArray_Check(py_val) ) {
+					pybytearray_to_val(self, err, py_val, &val, arena);
+				}
+				else {
+					as_error_update(err, AEROSPIKE_ERR_PARAM, "append or prepend to bin %s requires a string or bytearray", bin);
+				}
 				if ( err->code != AEROSPIKE_OK ) {
 					break;
 				}
-				as_record_set_map(rec, name, map);
-			}
-			else {
-			}
-		}
-
-		if ( py_meta && PyDict_Check(py_meta) ) {
-			PyObject * py_gen = PyDict_GetItemString(py_meta, "gen");
-			PyObject * py_ttl = PyDict_GetItemString(py_meta, "ttl");
-
-			if( py_ttl != NULL ){
-				if ( PyInt_Check(py_ttl) ) {
-					rec->ttl = (uint32_t) PyInt_AsLong(py_ttl);
+				if ( as_val_type(val) == AS_STRING ) {
+					char * s = as_string_get((as_string *) val);
+					if ( append ) {
+						as_operations_add_append_strp(ops, bin, s, false);
+					}
+					else {
+						as_operations_add_prepend_strp(ops, bin, s, false);
+					}
 				}
-				else if ( PyLong_Check(py_ttl) ) {
-					rec->ttl = (uint32_t) PyLong_AsLongLong(py_ttl);
+				else {
+					as_bytes * b = (as_bytes *) val;
+					if ( append ) {
+						as_operations_add_append_rawp(ops, bin, as_bytes_get(b), as_bytes_size(b), false);
+					}
+					else {
+						as_operations_add_prepend_rawp(ops, bin, as_bytes_get(b), as_bytes_size(b), false);
+					}
 				}
+				break;
 			}
-
-			if( py_gen != NULL ){
-				if ( PyInt_Check(py_gen) ) {
-					rec->gen = (uint16_t) PyInt_AsLong(py_gen);
-				}
-				else if ( PyLong_Check(py_gen) ) {
-					rec->gen = (uint16_t) PyLong_AsLongLong(py_gen);
-				}
+			default: {
+				as_error_update(err, AEROSPIKE_ERR_PARAM, "operator %ld is not supported", op);
+				break;
 			}
 		}
-	
+	}
 
-		if ( err->code != AEROSPIKE_OK ) {
-			as_record_destroy(rec);
-		}
+	// The metadata is parsed as for a put, into a record without bins
+	if ( err->code == AEROSPIKE_OK ) {
+		as_record meta;
+		as_record_init(&meta, 0);
+		meta.ttl = ops->ttl;
+		meta.gen = ops->gen;
+		pyobject_to_metadata(err, py_meta, &meta);
+		ops->ttl = meta.ttl;
+		ops->gen = meta.gen;
+		as_record_destroy(&meta);
+	}
+
+	if ( err->code != AEROSPIKE_OK ) {
+		as_operations_destroy(ops);
 	}
 
 	return err->code;
@@ -311,10 +784,10 @@ as_status pyobject_to_key(as_error * err, PyObject * py_keytuple, as_key * key)
 		}
 	}
 	
-	if ( py_key ) {
+	if ( py_key && py_key != Py_None ) {
 		if ( PyString_Check(py_key) ) {
 			char * k = PyString_AsString(py_key);
-			as_key_init_strp(key, ns, set, k, true);
+			as_key_init_strp(key, ns, set, k, false);
 		}
 		else if ( PyInt_Check(py_key) ) {
 			int64_t k = (int64_t) PyInt_AsLong(py_key);
@@ -331,8 +804,27 @@ as_status pyobject_to_key(as_error * err, PyObject * py_keytuple, as_key * key)
 			return as_error_update(err, AEROSPIKE_ERR_PARAM, "key is invalid");
 		}
 	}
-	else if ( py_digest ) {
-		return as_error_update(err, AEROSPIKE_ERR_PARAM, "digest is not supported");
+	else if ( py_digest && py_digest != Py_None ) {
+		char * digest = NULL;
+		Py_ssize_t digest_size = 0;
+
+		if ( PyByteArray_Check(py_digest) ) {
+			digest = PyByteArray_AsString(py_digest);
+			digest_size = PyByteArray_Size(py_digest);
+		}
+		else if ( PyString_Check(py_digest) ) {
+			digest = PyString_AsString(py_digest);
+			digest_size = PyString_Size(py_digest);
+		}
+		else {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "digest must be a bytearray or string");
+		}
+
+		if ( digest_size != AS_DIGEST_VALUE_SIZE ) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "digest must be %d bytes", AS_DIGEST_VALUE_SIZE);
+		}
+
+		as_key_init_digest(key, ns, set, (uint8_t *) digest);
 	}
 	else {
 		return as_error_update(err, AEROSPIKE_ERR_PARAM, "either key or digest is required");
@@ -341,28 +833,129 @@ as_status pyobject_to_key(as_error * err, PyObject * py_keytuple, as_key * key)
 	return err->code;
 }
 
+/**
+ * Converts a sequence of PyObject keys, as returned by PySequence_Fast(), into
+ * the keys of an as_batch. The batch must be initialized to hold as many keys
+ * as the sequence. The keys are also used to index the results, so they must
+ * be hashable.
+ * Returns AEROSPIKE_OK on success. On error, the err argument is populated.
+ */
+as_status pyobject_to_batch(as_error * err, PyObject * py_keys, as_batch * batch)
+{
+	as_error_reset(err);
+
+	uint32_t n_keys = (uint32_t) PySequence_Fast_GET_SIZE(py_keys);
+
+	// Zeroed keys are safe to destroy, should the conversion stop midway
+	memset(batch->keys.entries, 0, sizeof(as_key) * n_keys);
+
+	for ( uint32_t i = 0; i < n_keys; i++ ) {
+		PyObject * py_key = PySequence_Fast_GET_ITEM(py_keys, i);
+
+		if ( PyObject_Hash(py_key) == -1 ) {
+			PyErr_Clear();
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "keys must be hashable, such as tuples");
+		}
+
+		pyobject_to_key(err, py_key, as_batch_keyat(batch, i));
+		if ( err->code != AEROSPIKE_OK ) {
+			break;
+		}
+	}
+
+	return err->code;
+}
+
 typedef struct {
 	as_error * err;
 	uint32_t count;
 	void * udata;
+	PyObject * owner;
+	AerospikeClient * client;
 } conversion_data;
 
+static as_status list_to_pyobject_owned(AerospikeClient * self, as_error * err, const as_list * list, PyObject * owner, PyObject ** py_list);
 
-as_status val_to_pyobject(as_error * err, const as_val * val, PyObject ** py_val)
+static as_status map_to_pyobject_owned(AerospikeClient * self, as_error * err, const as_map * map, PyObject * owner, PyObject ** py_map);
+
+static as_status bins_to_pyobject_owned(AerospikeClient * self, as_error * err, const as_record * rec, PyObject * owner, PyObject ** py_bins);
+
+/**
+ * Compressed payloads of at least this many bytes are inflated without the
+ * GIL. Smaller ones inflate faster than the GIL is handed over.
+ */
+#define COMPRESSED_UNLOCKED_SIZE (16 * 1024)
+
+/**
+ * Converts a compressed bin to the value it was compressed from. Returns false
+ * when the bytes are not compressed.
+ */
+static bool compressed_to_pyobject(AerospikeClient * self, as_error * err, const as_bytes * bval, PyObject ** py_val)
+{
+	as_val_t val_type = AS_UNDEF;
+	as_bytes_type bytes_type = AS_BYTES_UNDEF;
+	uint8_t * data = NULL;
+	uint32_t size = 0;
+
+	// Most bytes bins are not compressed, so rule them out with the GIL held
+	if ( self == NULL || ! self->decompress || ! compression_is_compressed(bval) ) {
+		return false;
+	}
+
+	bool inflated = false;
+	if ( as_bytes_size(bval) >= COMPRESSED_UNLOCKED_SIZE ) {
+		PyThreadState * _save = PyEval_SaveThread();
+		inflated = compression_inflate(bval, &val_type, &bytes_type, &data, &size);
+		PyEval_RestoreThread(_save);
+	}
+	else {
+		inflated = compression_inflate(bval, &val_type, &bytes_type, &data, &size);
+	}
+
+	if ( ! inflated ) {
+		return false;
+	}
+
+	if ( val_type == AS_STRING ) {
+		*py_val = PyString_FromStringAndSize((char *) data, size);
+	}
+	else if ( self && self->deserializer.type != SERIALIZER_NONE && bytes_type == AS_BYTES_PYTHON ) {
+		serializer_load(&self->deserializer, err, data, size, py_val);
+	}
+	else {
+		*py_val = PyByteArray_FromStringAndSize((char *) data, size);
+	}
+
+	free(data);
+	return true;
+}
+
+as_status val_to_pyobject_owned(AerospikeClient * self, as_error * err, const as_val * val, PyObject * owner, PyObject ** py_val)
 {
 	as_error_reset(err);
 
 	switch( as_val_type(val) ) {
+		case AS_NIL: {
+			Py_INCREF(Py_None);
+			*py_val = Py_None;
+			break;
+		}
 		case AS_INTEGER: {
 			as_integer * i = as_integer_fromval(val);
 			*py_val = PyInt_FromLong((long) as_integer_get(i));
 			break;
 		}
+		case AS_DOUBLE: {
+			as_double * d = as_double_fromval(val);
+			*py_val = PyFloat_FromDouble(as_double_get(d));
+			break;
+		}
 		case AS_STRING: {
 			as_string * s = as_string_fromval(val);
 			char * str = as_string_get(s);
 			if ( str != NULL ) {
-				*py_val = PyString_FromString(str);
+				// The length is known from the wire, so skip the strlen()
+				*py_val = PyString_FromStringAndSize(str, (Py_ssize_t) as_string_len(s));
 			}
 			else {
 				Py_INCREF(Py_None);
@@ -373,16 +966,25 @@ as_status val_to_pyobject(as_error * err, const as_val * val, PyObject ** py_val
 		case AS_BYTES: {
 			as_bytes * bval = as_bytes_fromval(val);
 			uint32_t bval_size = as_bytes_size(bval);
-			uint8_t * bval_bytes = malloc(bval_size * sizeof(uint8_t));
-			memcpy(bval_bytes, as_bytes_get(bval), bval_size);
-			*py_val = PyByteArray_FromStringAndSize((char *) bval_bytes, bval_size);
+			if ( compressed_to_pyobject(self, err, bval, py_val) ) {
+				break;
+			}
+			if ( self && self->deserializer.type != SERIALIZER_NONE && as_bytes_get_type(bval) == AS_BYTES_PYTHON ) {
+				serializer_load(&self->deserializer, err, as_bytes_get(bval), bval_size, py_val);
+			}
+			else if ( owner ) {
+				*py_val = AerospikeBytesView_New(owner, as_bytes_get(bval), bval_size);
+			}
+			else {
+				*py_val = PyByteArray_FromStringAndSize((char *) as_bytes_get(bval), bval_size);
+			}
 			break;
 		}
 		case AS_LIST: {
 			as_list * l = as_list_fromval((as_val *) val);
 			if ( l != NULL ) {
 				PyObject * py_list = NULL;
-				list_to_pyobject(err, l, &py_list);
+				list_to_pyobject_owned(self, err, l, owner, &py_list);
 				if ( err->code == AEROSPIKE_OK ) {
 					*py_val = py_list;
 				}
@@ -393,7 +995,7 @@ as_status val_to_pyobject(as_error * err, const as_val * val, PyObject ** py_val
 			as_map * m = as_map_fromval(val);
 			if ( m != NULL ) {
 				PyObject * py_map = NULL;
-				map_to_pyobject(err, m, &py_map);
+				map_to_pyobject_owned(self, err, m, owner, &py_map);
 				if ( err->code == AEROSPIKE_OK ) {
 					*py_val = py_map;
 				}
@@ -404,7 +1006,7 @@ as_status val_to_pyobject(as_error * err, const as_val * val, PyObject ** py_val
 			as_record * r = as_record_fromval(val);
 			if ( r != NULL ) {
 				PyObject * py_rec = NULL;
-				record_to_pyobject(err, r, NULL, &py_rec);
+				record_to_pyobject(self, err, r, NULL, NULL, &py_rec);
 				if ( err->code == AEROSPIKE_OK ) {
 					*py_val = py_rec;
 				}
@@ -420,6 +1022,11 @@ as_status val_to_pyobject(as_error * err, const as_val * val, PyObject ** py_val
 	return err->code;
 }
 
+as_status val_to_pyobject(as_error * err, const as_val * val, PyObject ** py_val)
+{
+	return val_to_pyobject_owned(NULL, err, val, NULL, py_val);
+}
+
 static bool list_to_pyobject_each(as_val * val, void * udata)
 {
 	if ( val == NULL ) {
@@ -431,7 +1038,7 @@ static bool list_to_pyobject_each(as_val * val, void * udata)
 	PyObject * py_list = (PyObject *) convd->udata;
 
 	PyObject * py_val = NULL;
-	val_to_pyobject(convd->err, val, &py_val);
+	val_to_pyobject_owned(convd->client, convd->err, val, convd->owner, &py_val);
 
 	if ( err->code != AEROSPIKE_OK ) {
 		return false;
@@ -443,20 +1050,43 @@ static bool list_to_pyobject_each(as_val * val, void * udata)
 	return true;
 }
 
-as_status list_to_pyobject(as_error * err, const as_list * list, PyObject ** py_list)
+static as_status list_to_pyobject_owned(AerospikeClient * self, as_error * err, const as_list * list, PyObject * owner, PyObject ** py_list)
 {
 	*py_list = PyList_New(as_list_size((as_list *) list));
 
-	conversion_data convd = {
-		.err = err,
-		.count = 0,
-		.udata = *py_list
-	};
+	if ( list->hooks == &as_arraylist_list_hooks ) {
+		// The lists read from the database are arraylists, so their elements
+		// are converted in place, without a callback for each element
+		const as_arraylist * arraylist = (const as_arraylist *) list;
+
+		for ( uint32_t i = 0; i < arraylist->size; i++ ) {
+			PyObject * py_val = NULL;
+
+			if ( arraylist->elements[i] == NULL ) {
+				Py_INCREF(Py_None);
+				py_val = Py_None;
+			}
+			else if ( val_to_pyobject_owned(self, err, arraylist->elements[i], owner, &py_val) != AEROSPIKE_OK ) {
+				break;
+			}
 
-	as_list_foreach(list, list_to_pyobject_each, &convd);
+			PyList_SET_ITEM(*py_list, i, py_val);
+		}
+	}
+	else {
+		conversion_data convd = {
+			.err = err,
+			.count = 0,
+			.udata = *py_list,
+			.owner = owner,
+			.client = self
+		};
+
+		as_list_foreach(list, list_to_pyobject_each, &convd);
+	}
 
 	if ( err->code != AEROSPIKE_OK ) {
-		PyObject_Del(*py_list);
+		Py_DECREF(*py_list);
 		*py_list = NULL;
 		return err->code;
 	}
@@ -464,6 +1094,11 @@ as_status list_to_pyobject(as_error * err, const as_list * list, PyObject ** py_
 	return err->code;
 }
 
+as_status list_to_pyobject(as_error * err, const as_list * list, PyObject ** py_list)
+{
+	return list_to_pyobject_owned(NULL, err, list, NULL, py_list);
+}
+
 static bool map_to_pyobject_each(const as_val * key, const as_val * val, void * udata)
 {
 	if ( key == NULL || val == NULL ) {
@@ -475,21 +1110,27 @@ static bool map_to_pyobject_each(const as_val * key, const as_val * val, void *
 	PyObject * py_dict = (PyObject *) convd->udata;
 
 	PyObject * py_key = NULL;
-	val_to_pyobject(convd->err, key, &py_key);
+	val_to_pyobject_owned(convd->client, convd->err, key, NULL, &py_key);
 
 	if ( err->code != AEROSPIKE_OK ) {
 		return false;
 	}
 
+	// Bytes keys are read as str, as for flattened results
+	py_key = unpack_map_key(py_key);
+
 	PyObject * py_val = NULL;
-	val_to_pyobject(convd->err, val, &py_val);
+	val_to_pyobject_owned(convd->client, convd->err, val, convd->owner, &py_val);
 
 	if ( err->code != AEROSPIKE_OK ) {
-		PyObject_Del(py_key);
+		Py_DECREF(py_key);
 		return false;
 	}
 
-	PyDict_SetItem(py_dict, py_key, py_val);
+	if ( PyDict_SetItem(py_dict, py_key, py_val) != 0 ) {
+		// Keys which are not hashable are skipped, as for flattened results
+		PyErr_Clear();
+	}
 
 	Py_DECREF(py_key);
 	Py_DECREF(py_val);
@@ -498,27 +1139,35 @@ static bool map_to_pyobject_each(const as_val * key, const as_val * val, void *
 	return true;
 }
 
-as_status map_to_pyobject(as_error * err, const as_map * map, PyObject ** py_map)
+static as_status map_to_pyobject_owned(AerospikeClient * self, as_error * err, const as_map * map, PyObject * owner, PyObject ** py_map)
 {
-	*py_map = PyDict_New();
+	*py_map = _PyDict_NewPresized(as_map_size(map));
 
 	conversion_data convd = {
 		.err = err,
 		.count = 0,
-		.udata = *py_map
+		.udata = *py_map,
+		.owner = owner,
+		.client = self
 	};
 
 	as_map_foreach(map, map_to_pyobject_each, &convd);
 
 	if ( err->code != AEROSPIKE_OK ) {
-		PyObject_Del(*py_map);
+		Py_DECREF(*py_map);
+		*py_map = NULL;
 		return err->code;
 	}
 
 	return err->code;
 }
 
-as_status record_to_pyobject(as_error * err, const as_record * rec, const as_key * key, PyObject ** obj)
+as_status map_to_pyobject(as_error * err, const as_map * map, PyObject ** py_map)
+{
+	return map_to_pyobject_owned(NULL, err, map, NULL, py_map);
+}
+
+as_status record_to_pyobject(AerospikeClient * self, as_error * err, const as_record * rec, const as_key * key, PyObject * py_key, PyObject ** obj)
 {
 	as_error_reset(err);
 
@@ -531,9 +1180,9 @@ as_status record_to_pyobject(as_error * err, const as_record * rec, const as_key
 	PyObject * py_rec_meta = NULL;
 	PyObject * py_rec_bins = NULL;
 
-	key_to_pyobject(err, key ? key : &rec->key, &py_rec_key);
+	result_key_to_pyobject(self, err, key ? key : &rec->key, py_key, &py_rec_key);
 	metadata_to_pyobject(err, rec, &py_rec_meta);
-	bins_to_pyobject(err, rec, &py_rec_bins);
+	bins_to_pyobject(self, err, rec, &py_rec_bins);
 
 	py_rec = PyTuple_New(3);
 	PyTuple_SetItem(py_rec, 0, py_rec_key);
@@ -545,6 +1194,51 @@ as_status record_to_pyobject(as_error * err, const as_record * rec, const as_key
 	return err->code;
 }
 
+static void record_capsule_destroy(PyObject * py_capsule)
+{
+	as_record_destroy((as_record *) PyCapsule_GetPointer(py_capsule, "aerospike.record"));
+}
+
+PyObject * record_to_capsule(as_record * rec)
+{
+	return PyCapsule_New(rec, "aerospike.record", record_capsule_destroy);
+}
+
+as_status record_to_pyobject_view(AerospikeClient * self, as_error * err, as_record ** rec, const as_key * key, PyObject * py_key, PyObject ** obj)
+{
+	as_error_reset(err);
+
+	if ( ! *rec ) {
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "record is null");
+	}
+
+	// The capsule owns the record from here on, and is kept alive by the views
+	PyObject * py_owner = record_to_capsule(*rec);
+	const as_record * r = *rec;
+	*rec = NULL;
+
+	PyObject * py_rec = NULL;
+	PyObject * py_rec_key = NULL;
+	PyObject * py_rec_meta = NULL;
+	PyObject * py_rec_bins = NULL;
+
+	result_key_to_pyobject(self, err, key ? key : &r->key, py_key, &py_rec_key);
+	metadata_to_pyobject(err, r, &py_rec_meta);
+	bins_to_pyobject_owned(self, err, r, py_owner, &py_rec_bins);
+
+	py_rec = PyTuple_New(3);
+	PyTuple_SetItem(py_rec, 0, py_rec_key);
+	PyTuple_SetItem(py_rec, 1, py_rec_meta);
+	PyTuple_SetItem(py_rec, 2, py_rec_bins);
+
+	// Destroys the record, unless a view references it
+	Py_DECREF(py_owner);
+
+	*obj = py_rec;
+
+	return err->code;
+}
+
 as_status key_to_pyobject(as_error * err, const as_key * key, PyObject ** obj)
 {
 	as_error_reset(err);
@@ -579,16 +1273,13 @@ as_status key_to_pyobject(as_error * err, const as_key * key, PyObject ** obj)
 			}
             case AS_STRING: {
 				as_string * sval = as_string_fromval(val);
-				py_key = PyString_FromString(as_string_get(sval));
+				py_key = PyString_FromStringAndSize(as_string_get(sval), (Py_ssize_t) as_string_len(sval));
 				break;
 			}
             case AS_BYTES: {
 				as_bytes * bval = as_bytes_fromval(val);
 				if ( bval ) {
-					uint32_t bval_size = as_bytes_size(bval);
-					uint8_t * bval_bytes = malloc(bval_size * sizeof(uint8_t));
-					memcpy(bval_bytes, as_bytes_get(bval), bval_size);
-					py_key = PyByteArray_FromStringAndSize((char *) bval_bytes, bval_size);
+					py_key = PyByteArray_FromStringAndSize((char *) as_bytes_get(bval), as_bytes_size(bval));
 				}
 				break;
 			}
@@ -599,9 +1290,7 @@ as_status key_to_pyobject(as_error * err, const as_key * key, PyObject ** obj)
     }
 
     if ( key->digest.init ) {
-		uint8_t * digest_bytes = malloc(AS_DIGEST_VALUE_SIZE * sizeof(uint8_t));
-		memcpy(digest_bytes, key->digest.value, AS_DIGEST_VALUE_SIZE);
-		py_digest = PyByteArray_FromStringAndSize((char *) digest_bytes, AS_DIGEST_VALUE_SIZE);
+		py_digest = PyString_FromStringAndSize((char *) key->digest.value, AS_DIGEST_VALUE_SIZE);
     }
 
 	PyObject * py_keyobj = PyTuple_New(4);
@@ -616,32 +1305,21 @@ as_status key_to_pyobject(as_error * err, const as_key * key, PyObject ** obj)
 	return err->code;
 }
 
-static bool bins_to_pyobject_each(const char * name, const as_val * val, void * udata)
+as_status result_key_to_pyobject(AerospikeClient * self, as_error * err, const as_key * key, PyObject * py_key, PyObject ** obj)
 {
-	if ( name == NULL || val == NULL ) {
-		return false;
-	}
-
-	conversion_data * convd = (conversion_data *) udata;
-	as_error * err = convd->err;
-	PyObject * py_bins = (PyObject *) convd->udata;
-	PyObject * py_val = NULL;
-
-	val_to_pyobject(err, val, &py_val);
-
-	if ( err->code != AEROSPIKE_OK ) {
-		return false;
+	if ( py_key == NULL || self == NULL || ! self->reuse_keys ) {
+		return key_to_pyobject(err, key, obj);
 	}
 
-	PyDict_SetItemString(py_bins, name, py_val);
+	as_error_reset(err);
 
-	Py_DECREF(py_val);
+	Py_INCREF(py_key);
+	*obj = py_key;
 
-	convd->count++;
-	return true;
+	return err->code;
 }
 
-as_status bins_to_pyobject(as_error * err, const as_record * rec, PyObject ** py_bins)
+static as_status bins_to_pyobject_owned(AerospikeClient * self, as_error * err, const as_record * rec, PyObject * owner, PyObject ** py_bins)
 {
 	as_error_reset(err);
 
@@ -650,18 +1328,36 @@ as_status bins_to_pyobject(as_error * err, const as_record * rec, PyObject ** py
 		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "record is null");
 	}
 
-	*py_bins = PyDict_New();
+	*py_bins = _PyDict_NewPresized(rec->bins.size);
 
-	conversion_data convd = {
-		.err = err,
-		.count = 0,
-		.udata = *py_bins
-	};
+	// The bins are read in place, rather than through the record's hooks
+	for ( uint16_t i = 0; i < rec->bins.size; i++ ) {
+		const as_bin * bin = &rec->bins.entries[i];
+		PyObject * py_val = NULL;
 
-	as_record_foreach(rec, bins_to_pyobject_each, &convd);
+		if ( bin->valuep == NULL ) {
+			continue;
+		}
+
+		if ( val_to_pyobject_owned(self, err, (as_val *) bin->valuep, owner, &py_val) != AEROSPIKE_OK ) {
+			break;
+		}
+
+		if ( self ) {
+			// Bin names repeat across records, so share one string for each name
+			PyObject * py_name = intern_table_get(self->bin_names, bin->name);
+			PyDict_SetItem(*py_bins, py_name, py_val);
+			Py_DECREF(py_name);
+		}
+		else {
+			PyDict_SetItemString(*py_bins, bin->name, py_val);
+		}
+
+		Py_DECREF(py_val);
+	}
 
 	if ( err->code != AEROSPIKE_OK ) {
-		PyObject_Del(*py_bins);
+		Py_DECREF(*py_bins);
 		*py_bins = NULL;
 		return err->code;
 	}
@@ -669,6 +1365,11 @@ as_status bins_to_pyobject(as_error * err, const as_record * rec, PyObject ** py
 	return err->code;
 }
 
+as_status bins_to_pyobject(AerospikeClient * self, as_error * err, const as_record * rec, PyObject ** py_bins)
+{
+	return bins_to_pyobject_owned(self, err, rec, NULL, py_bins);
+}
+
 as_status metadata_to_pyobject(as_error * err, const as_record * rec, PyObject ** obj)
 {
 	as_error_reset(err);
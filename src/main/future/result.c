@@ -0,0 +1,172 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+#include <sys/time.h>
+
+#include <aerospike/as_error.h>
+
+#include "async.h"
+#include "client.h"
+#include "conversions.h"
+#include "future.h"
+
+/**
+ * The longest the wait is without checking for signals or a closed client.
+ */
+#define RESULT_WAIT_MS 100
+
+static int64_t now_ms()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (int64_t) tv.tv_sec * 1000 + tv.tv_usec / 1000;
+}
+
+PyObject * AerospikeFuture_Done(AerospikeFuture * self, PyObject * args, PyObject * kwds)
+{
+	return PyBool_FromLong(self->done);
+}
+
+PyObject * AerospikeFuture_Result(AerospikeFuture * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Arguments
+	PyObject * py_timeout = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"timeout", NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "|O:result", kwlist, &py_timeout) == false ) {
+		return NULL;
+	}
+
+	as_error err;
+	as_error_init(&err);
+
+	int64_t deadline = -1;
+	if ( py_timeout && py_timeout != Py_None ) {
+		double timeout = PyFloat_AsDouble(py_timeout);
+		if ( PyErr_Occurred() ) {
+			return NULL;
+		}
+		deadline = now_ms() + (int64_t) (timeout * 1000);
+	}
+
+	// Drive the completions of the client, until this future is done
+	while ( ! self->done ) {
+
+		async_engine * engine = self->client->async;
+		if ( engine == NULL ) {
+			as_error_update(&err, AEROSPIKE_ERR_CLIENT, "client is closed");
+			break;
+		}
+
+		int wait_ms = RESULT_WAIT_MS;
+		if ( deadline >= 0 ) {
+			int64_t remaining = deadline - now_ms();
+			if ( remaining <= 0 ) {
+				as_error_update(&err, AEROSPIKE_ERR_TIMEOUT, "future is not done");
+				break;
+			}
+			if ( remaining < wait_ms ) {
+				wait_ms = (int) remaining;
+			}
+		}
+
+		// The client may be closed by another thread while we wait
+		async_engine_retain(engine);
+		PyThreadState * _save = PyEval_SaveThread();
+		async_engine_wait(engine, wait_ms);
+		PyEval_RestoreThread(_save);
+		async_engine_release(engine);
+
+		if ( PyErr_CheckSignals() != 0 ) {
+			return NULL;
+		}
+
+		// The future is completed, and its client cleared, if the client
+		// was closed meanwhile
+		if ( ! self->done ) {
+			AerospikeClient_Async_Process(self->client);
+		}
+	}
+
+	if ( err.code != AEROSPIKE_OK ) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyErr_SetObject(PyExc_Exception, py_err);
+		return NULL;
+	}
+
+	if ( self->error ) {
+		PyErr_SetObject(PyExc_Exception, self->error);
+		return NULL;
+	}
+
+	Py_INCREF(self->result);
+	return self->result;
+}
+
+PyObject * AerospikeFuture_Exception(AerospikeFuture * self, PyObject * args, PyObject * kwds)
+{
+	PyObject * py_err = self->error ? self->error : Py_None;
+	Py_INCREF(py_err);
+	return py_err;
+}
+
+PyObject * AerospikeFuture_Add_Done_Callback(AerospikeFuture * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Arguments
+	PyObject * py_callback = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"callback", NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "O:add_done_callback", kwlist, &py_callback) == false ) {
+		return NULL;
+	}
+
+	if ( ! PyCallable_Check(py_callback) ) {
+		as_error err;
+		as_error_init(&err);
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "callback must be callable");
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyErr_SetObject(PyExc_Exception, py_err);
+		return NULL;
+	}
+
+	if ( self->done ) {
+		PyObject * py_ret = PyObject_CallFunctionObjArgs(py_callback, (PyObject *) self, NULL);
+		if ( py_ret == NULL ) {
+			return NULL;
+		}
+		Py_DECREF(py_ret);
+		Py_INCREF(Py_None);
+		return Py_None;
+	}
+
+	if ( self->callbacks == NULL ) {
+		self->callbacks = PyList_New(0);
+	}
+	PyList_Append(self->callbacks, py_callback);
+
+	Py_INCREF(Py_None);
+	return Py_None;
+}
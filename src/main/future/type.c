@@ -0,0 +1,202 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <structmember.h>
+#include <stdbool.h>
+
+#include "client.h"
+#include "future.h"
+
+/*******************************************************************************
+ * PYTHON TYPE METHODS
+ ******************************************************************************/
+
+static PyMethodDef AerospikeFuture_Type_Methods[] = {
+
+    {"done",				(PyCFunction) AerospikeFuture_Done,					METH_VARARGS | METH_KEYWORDS,
+    						"Whether the operation has completed."},
+
+    {"result",				(PyCFunction) AerospikeFuture_Result,				METH_VARARGS | METH_KEYWORDS,
+    						"Return the result of the operation, waiting for it if needed."},
+
+    {"exception",			(PyCFunction) AerospikeFuture_Exception,			METH_VARARGS | METH_KEYWORDS,
+    						"Return the error of the operation, or None."},
+
+    {"add_done_callback",	(PyCFunction) AerospikeFuture_Add_Done_Callback,	METH_VARARGS | METH_KEYWORDS,
+    						"Call the callback with the future, once the operation completes."},
+
+	{NULL}
+};
+
+/*******************************************************************************
+ * PYTHON TYPE HOOKS
+ ******************************************************************************/
+
+static PyObject * AerospikeFuture_Type_New(PyTypeObject * type, PyObject * args, PyObject * kwds)
+{
+	AerospikeFuture * self = NULL;
+
+    self = (AerospikeFuture *) type->tp_alloc(type, 0);
+
+    if ( self == NULL ) {
+    	return NULL;
+    }
+
+	return (PyObject *) self;
+}
+
+/**
+ * Futures are iterators, like asyncio futures, so a coroutine can wait for
+ * one with `yield from`. Each step completes the finished operations of the
+ * client, and yields None, which reschedules the coroutine, until the future
+ * is done. The result is then returned through StopIteration.
+ */
+static PyObject * AerospikeFuture_Type_Iter(AerospikeFuture * self)
+{
+	Py_INCREF(self);
+	return (PyObject *) self;
+}
+
+static PyObject * AerospikeFuture_Type_Iternext(AerospikeFuture * self)
+{
+	if ( ! self->done && self->client ) {
+		AerospikeClient_Async_Process(self->client);
+	}
+
+	if ( ! self->done ) {
+		Py_INCREF(Py_None);
+		return Py_None;
+	}
+
+	if ( self->error ) {
+		PyErr_SetObject(PyExc_Exception, self->error);
+		return NULL;
+	}
+
+	// The result is the value of the StopIteration, as for a generator
+	PyObject * py_stop = PyObject_CallFunctionObjArgs(PyExc_StopIteration, self->result, NULL);
+	if ( py_stop != NULL ) {
+		PyErr_SetObject(PyExc_StopIteration, py_stop);
+		Py_DECREF(py_stop);
+	}
+	return NULL;
+}
+
+static void AerospikeFuture_Type_Dealloc(AerospikeFuture * self)
+{
+	Py_XDECREF(self->result);
+	Py_XDECREF(self->error);
+	Py_XDECREF(self->callbacks);
+    self->ob_type->tp_free((PyObject *) self);
+}
+
+/*******************************************************************************
+ * PYTHON TYPE DESCRIPTOR
+ ******************************************************************************/
+
+static PyTypeObject AerospikeFuture_Type = {
+	PyObject_HEAD_INIT(NULL)
+
+    .ob_size			= 0,
+    .tp_name			= "aerospike.Future",
+    .tp_basicsize		= sizeof(AerospikeFuture),
+    .tp_itemsize		= 0,
+    .tp_dealloc			= (destructor) AerospikeFuture_Type_Dealloc,
+    .tp_print			= 0,
+    .tp_getattr			= 0,
+    .tp_setattr			= 0,
+    .tp_compare			= 0,
+    .tp_repr			= 0,
+    .tp_as_number		= 0,
+    .tp_as_sequence		= 0,
+    .tp_as_mapping		= 0,
+    .tp_hash			= 0,
+    .tp_call			= 0,
+    .tp_str				= 0,
+    .tp_getattro		= 0,
+    .tp_setattro		= 0,
+    .tp_as_buffer		= 0,
+    .tp_flags			= Py_TPFLAGS_DEFAULT,
+    .tp_doc				= 
+    		"The Future class represents an asynchronous operation. Instances\n"
+    		"are returned by the *_async() methods of the Client class. Like an\n"
+    		"asyncio future, a coroutine can wait for one by iterating it.\n",
+    .tp_traverse		= 0,
+    .tp_clear			= 0,
+    .tp_richcompare		= 0,
+    .tp_weaklistoffset	= 0,
+    .tp_iter			= (getiterfunc) AerospikeFuture_Type_Iter,
+    .tp_iternext		= (iternextfunc) AerospikeFuture_Type_Iternext,
+    .tp_methods			= AerospikeFuture_Type_Methods,
+    .tp_members			= 0,
+    .tp_getset			= 0,
+    .tp_base			= 0,
+    .tp_dict			= 0,
+    .tp_descr_get		= 0,
+    .tp_descr_set		= 0,
+    .tp_dictoffset		= 0,
+    .tp_init			= 0,
+    .tp_alloc			= 0,
+    .tp_new				= 0
+};
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+PyTypeObject * AerospikeFuture_Ready()
+{
+	return PyType_Ready(&AerospikeFuture_Type) == 0 ? &AerospikeFuture_Type : NULL;
+}
+
+AerospikeFuture * AerospikeFuture_New(AerospikeClient * client)
+{
+	AerospikeFuture * self = (AerospikeFuture *) AerospikeFuture_Type_New(&AerospikeFuture_Type, NULL, NULL);
+	if ( self == NULL ) {
+		return NULL;
+	}
+	self->client = client;
+	return self;
+}
+
+void AerospikeFuture_Complete(AerospikeFuture * self, PyObject * py_result, PyObject * py_err)
+{
+	self->result = py_result;
+	self->error = py_err;
+	self->done = true;
+	self->client = NULL;
+
+	PyObject * py_callbacks = self->callbacks;
+	self->callbacks = NULL;
+
+	if ( py_callbacks == NULL ) {
+		return;
+	}
+
+	Py_ssize_t size = PyList_Size(py_callbacks);
+	for ( Py_ssize_t i = 0; i < size; i++ ) {
+		PyObject * py_callback = PyList_GetItem(py_callbacks, i);
+		PyObject * py_ret = PyObject_CallFunctionObjArgs(py_callback, (PyObject *) self, NULL);
+		if ( py_ret == NULL ) {
+			// A failing callback must not prevent the others from running
+			PyErr_Print();
+		}
+		Py_XDECREF(py_ret);
+	}
+
+	Py_DECREF(py_callbacks);
+}
@@ -0,0 +1,134 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "intern.h"
+
+#define INTERN_TABLE_CAPACITY_INITIAL 64
+
+// Bounds the memory held by the table, when bin names are not a fixed set
+#define INTERN_TABLE_SIZE_MAX 32768
+
+typedef struct {
+	uint32_t hash;
+	PyObject * py_name;
+} intern_entry;
+
+/**
+ * An open addressing hash table, with linear probing. The capacity is a power
+ * of two, and is kept at least twice the size.
+ */
+struct intern_table_s {
+	uint32_t capacity;
+	uint32_t size;
+	intern_entry * entries;
+};
+
+static uint32_t intern_hash(const char * name)
+{
+	// FNV-1a
+	uint32_t hash = 2166136261u;
+	for ( const uint8_t * p = (const uint8_t *) name; *p; p++ ) {
+		hash ^= *p;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+static void intern_table_grow(intern_table * table)
+{
+	uint32_t capacity = table->capacity * 2;
+	intern_entry * entries = (intern_entry *) calloc(capacity, sizeof(intern_entry));
+
+	for ( uint32_t i = 0; i < table->capacity; i++ ) {
+		intern_entry * entry = &table->entries[i];
+		if ( entry->py_name ) {
+			uint32_t j = entry->hash & (capacity - 1);
+			while ( entries[j].py_name ) {
+				j = (j + 1) & (capacity - 1);
+			}
+			entries[j] = *entry;
+		}
+	}
+
+	free(table->entries);
+	table->entries = entries;
+	table->capacity = capacity;
+}
+
+intern_table * intern_table_new()
+{
+	intern_table * table = (intern_table *) malloc(sizeof(intern_table));
+	table->capacity = INTERN_TABLE_CAPACITY_INITIAL;
+	table->size = 0;
+	table->entries = (intern_entry *) calloc(table->capacity, sizeof(intern_entry));
+	return table;
+}
+
+void intern_table_destroy(intern_table * table)
+{
+	if ( ! table ) {
+		return;
+	}
+
+	for ( uint32_t i = 0; i < table->capacity; i++ ) {
+		Py_XDECREF(table->entries[i].py_name);
+	}
+
+	free(table->entries);
+	free(table);
+}
+
+PyObject * intern_table_get(intern_table * table, const char * name)
+{
+	uint32_t hash = intern_hash(name);
+	uint32_t i = hash & (table->capacity - 1);
+
+	for ( ; table->entries[i].py_name; i = (i + 1) & (table->capacity - 1) ) {
+		intern_entry * entry = &table->entries[i];
+		if ( entry->hash == hash && strcmp(PyString_AS_STRING(entry->py_name), name) == 0 ) {
+			Py_INCREF(entry->py_name);
+			return entry->py_name;
+		}
+	}
+
+	if ( table->size >= INTERN_TABLE_SIZE_MAX ) {
+		return PyString_FromString(name);
+	}
+
+	PyObject * py_name = PyString_FromString(name);
+	if ( py_name == NULL ) {
+		return NULL;
+	}
+
+	// Computes and caches the hash of the string, for the dicts it will key
+	PyObject_Hash(py_name);
+
+	table->entries[i].hash = hash;
+	table->entries[i].py_name = py_name;
+	table->size++;
+
+	if ( table->size * 2 > table->capacity ) {
+		intern_table_grow(table);
+	}
+
+	Py_INCREF(py_name);
+	return py_name;
+}
@@ -0,0 +1,517 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <aerospike/as_bytes.h>
+#include <aerospike/as_double.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_integer.h>
+#include <aerospike/as_list.h>
+#include <aerospike/as_map.h>
+#include <aerospike/as_record.h>
+#include <aerospike/as_string.h>
+#include <aerospike/as_val.h>
+
+#include "compression.h"
+#include "json.h"
+
+/**
+ * The depth of nested lists and maps at which the encoder gives up, rather
+ * than overflow the stack on a cyclic value.
+ */
+#define JSON_MAX_DEPTH 256
+
+/*******************************************************************************
+ * OUTPUT
+ ******************************************************************************/
+
+typedef struct {
+	char * data;
+	size_t size;
+	size_t capacity;
+} json_buffer;
+
+static char * json_reserve(json_buffer * b, size_t n)
+{
+	if ( b->size + n > b->capacity ) {
+		size_t capacity = b->capacity ? b->capacity * 2 : 256;
+		while ( capacity < b->size + n ) {
+			capacity *= 2;
+		}
+		b->data = (char *) realloc(b->data, capacity);
+		b->capacity = capacity;
+	}
+	char * p = b->data + b->size;
+	b->size += n;
+	return p;
+}
+
+static void json_raw(json_buffer * b, const char * data, size_t size)
+{
+	if ( size > 0 ) {
+		memcpy(json_reserve(b, size), data, size);
+	}
+}
+
+static void json_literal(json_buffer * b, const char * str)
+{
+	json_raw(b, str, strlen(str));
+}
+
+static void json_string(json_buffer * b, const char * str, size_t len)
+{
+	static const char hex[] = "0123456789abcdef";
+
+	json_raw(b, "\"", 1);
+
+	size_t start = 0;
+	for ( size_t i = 0; i < len; i++ ) {
+		uint8_t c = (uint8_t) str[i];
+		if ( c >= 0x20 && c != '"' && c != '\\' ) {
+			continue;
+		}
+
+		json_raw(b, str + start, i - start);
+		start = i + 1;
+
+		switch ( c ) {
+			case '"':	json_raw(b, "\\\"", 2); break;
+			case '\\':	json_raw(b, "\\\\", 2); break;
+			case '\n':	json_raw(b, "\\n", 2); break;
+			case '\r':	json_raw(b, "\\r", 2); break;
+			case '\t':	json_raw(b, "\\t", 2); break;
+			case '\b':	json_raw(b, "\\b", 2); break;
+			case '\f':	json_raw(b, "\\f", 2); break;
+			default: {
+				char * p = json_reserve(b, 6);
+				memcpy(p, "\\u00", 4);
+				p[4] = hex[c >> 4];
+				p[5] = hex[c & 0x0f];
+				break;
+			}
+		}
+	}
+
+	json_raw(b, str + start, len - start);
+	json_raw(b, "\"", 1);
+}
+
+static void json_base64(json_buffer * b, const uint8_t * data, size_t size)
+{
+	static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	char * p = json_reserve(b, 2 + (size + 2) / 3 * 4);
+
+	*p++ = '"';
+	size_t i = 0;
+	for ( ; i + 2 < size; i += 3 ) {
+		uint32_t v = ((uint32_t) data[i] << 16) | ((uint32_t) data[i + 1] << 8) | data[i + 2];
+		*p++ = alphabet[(v >> 18) & 0x3f];
+		*p++ = alphabet[(v >> 12) & 0x3f];
+		*p++ = alphabet[(v >> 6) & 0x3f];
+		*p++ = alphabet[v & 0x3f];
+	}
+	if ( i < size ) {
+		uint32_t v = (uint32_t) data[i] << 16;
+		if ( i + 1 < size ) {
+			v |= (uint32_t) data[i + 1] << 8;
+		}
+		*p++ = alphabet[(v >> 18) & 0x3f];
+		*p++ = alphabet[(v >> 12) & 0x3f];
+		*p++ = i + 1 < size ? alphabet[(v >> 6) & 0x3f] : '=';
+		*p++ = '=';
+	}
+	*p++ = '"';
+}
+
+static void json_int(json_buffer * b, int64_t v)
+{
+	char str[24];
+	int len = snprintf(str, sizeof(str), "%lld", (long long) v);
+	json_raw(b, str, (size_t) len);
+}
+
+/**
+ * Writes the shortest form of the float which reads back as the same value,
+ * with a ".0" for integral values, as repr() would.
+ */
+static void json_double(json_buffer * b, double d)
+{
+	if ( ! isfinite(d) ) {
+		json_literal(b, "null");
+		return;
+	}
+
+	char str[32];
+	for ( int precision = 15; precision <= 17; precision++ ) {
+		snprintf(str, sizeof(str), "%.*g", precision, d);
+		if ( strtod(str, NULL) == d ) {
+			break;
+		}
+	}
+
+	json_literal(b, str);
+	if ( strpbrk(str, ".en") == NULL ) {
+		json_raw(b, ".0", 2);
+	}
+}
+
+/*******************************************************************************
+ * AS_VAL ENCODER
+ ******************************************************************************/
+
+typedef struct {
+	json_buffer * buffer;
+	as_error * err;
+	int depth;
+	bool first;
+	bool decompress;
+} json_data;
+
+static bool json_val(json_data * j, const as_val * val);
+
+/**
+ * Writes the separator before an element of a list or map.
+ */
+static void json_next(json_data * j)
+{
+	if ( ! j->first ) {
+		json_raw(j->buffer, ",", 1);
+	}
+	j->first = false;
+}
+
+static bool json_list_each(as_val * val, void * udata)
+{
+	json_data * j = (json_data *) udata;
+	json_next(j);
+	return json_val(j, val);
+}
+
+/**
+ * Writes a map key. JSON keys are strings, so other keys are written as the
+ * string of their value.
+ */
+static bool json_key(json_data * j, const as_val * key)
+{
+	json_buffer * b = j->buffer;
+
+	switch ( key ? as_val_type(key) : AS_NIL ) {
+		case AS_STRING: {
+			return json_val(j, key);
+		}
+		case AS_BYTES: {
+			return json_val(j, key);
+		}
+		case AS_INTEGER:
+		case AS_DOUBLE: {
+			json_raw(b, "\"", 1);
+			json_val(j, key);
+			json_raw(b, "\"", 1);
+			return true;
+		}
+		case AS_NIL: {
+			json_literal(b, "\"null\"");
+			return true;
+		}
+		default: {
+			as_error_update(j->err, AEROSPIKE_ERR_CLIENT, "map key of type %d can not be encoded as JSON", as_val_type(key));
+			return false;
+		}
+	}
+}
+
+static bool json_map_each(const as_val * key, const as_val * val, void * udata)
+{
+	json_data * j = (json_data *) udata;
+	json_next(j);
+	if ( ! json_key(j, key) ) {
+		return false;
+	}
+	json_raw(j->buffer, ":", 1);
+	return json_val(j, val);
+}
+
+static bool json_bytes(json_data * j, const as_bytes * bval)
+{
+	as_val_t val_type = AS_UNDEF;
+	as_bytes_type bytes_type = AS_BYTES_UNDEF;
+	uint8_t * data = NULL;
+	uint32_t size = 0;
+
+	if ( j->decompress && compression_inflate(bval, &val_type, &bytes_type, &data, &size) ) {
+		if ( val_type == AS_STRING ) {
+			json_string(j->buffer, (const char *) data, size);
+		}
+		else {
+			json_base64(j->buffer, data, size);
+		}
+		free(data);
+	}
+	else {
+		json_base64(j->buffer, as_bytes_get(bval), as_bytes_size(bval));
+	}
+
+	return true;
+}
+
+static bool json_val(json_data * j, const as_val * val)
+{
+	json_buffer * b = j->buffer;
+
+	switch ( val ? as_val_type(val) : AS_NIL ) {
+		case AS_NIL: {
+			json_literal(b, "null");
+			return true;
+		}
+		case AS_INTEGER: {
+			json_int(b, as_integer_get(as_integer_fromval(val)));
+			return true;
+		}
+		case AS_DOUBLE: {
+			json_double(b, as_double_get(as_double_fromval(val)));
+			return true;
+		}
+		case AS_STRING: {
+			as_string * s = as_string_fromval(val);
+			char * str = as_string_get(s);
+			if ( str != NULL ) {
+				json_string(b, str, as_string_len(s));
+			}
+			else {
+				json_literal(b, "null");
+			}
+			return true;
+		}
+		case AS_BYTES: {
+			return json_bytes(j, as_bytes_fromval(val));
+		}
+		case AS_LIST:
+		case AS_MAP: {
+			if ( j->depth >= JSON_MAX_DEPTH ) {
+				as_error_update(j->err, AEROSPIKE_ERR_CLIENT, "value is nested too deeply to encode as JSON");
+				return false;
+			}
+
+			bool list = as_val_type(val) == AS_LIST;
+			json_raw(b, list ? "[" : "{", 1);
+
+			j->depth++;
+			j->first = true;
+			if ( list ) {
+				as_list_foreach(as_list_fromval((as_val *) val), json_list_each, j);
+			}
+			else {
+				as_map_foreach(as_map_fromval(val), json_map_each, j);
+			}
+			j->depth--;
+			j->first = false;
+
+			json_raw(b, list ? "]" : "}", 1);
+			return j->err->code == AEROSPIKE_OK;
+		}
+		default: {
+			as_error_update(j->err, AEROSPIKE_ERR_CLIENT, "value of type %d can not be encoded as JSON", as_val_type(val));
+			return false;
+		}
+	}
+}
+
+/*******************************************************************************
+ * PYOBJECT ENCODER
+ ******************************************************************************/
+
+static bool json_pyobject(json_data * j, PyObject * py_obj);
+
+static bool json_pykey(json_data * j, PyObject * py_key)
+{
+	json_buffer * b = j->buffer;
+
+	if ( PyString_Check(py_key) || PyUnicode_Check(py_key) ) {
+		return json_pyobject(j, py_key);
+	}
+	if ( py_key == Py_None || PyBool_Check(py_key) ) {
+		json_literal(b, py_key == Py_None ? "\"null\"" : py_key == Py_True ? "\"true\"" : "\"false\"");
+		return true;
+	}
+	if ( PyInt_Check(py_key) || PyLong_Check(py_key) || PyFloat_Check(py_key) ) {
+		json_raw(b, "\"", 1);
+		json_pyobject(j, py_key);
+		json_raw(b, "\"", 1);
+		return true;
+	}
+
+	as_error_update(j->err, AEROSPIKE_ERR_CLIENT, "map key of type %s can not be encoded as JSON", Py_TYPE(py_key)->tp_name);
+	return false;
+}
+
+static bool json_pyobject(json_data * j, PyObject * py_obj)
+{
+	json_buffer * b = j->buffer;
+
+	if ( py_obj == Py_None ) {
+		json_literal(b, "null");
+	}
+	else if ( PyBool_Check(py_obj) ) {
+		json_literal(b, py_obj == Py_True ? "true" : "false");
+	}
+	else if ( PyInt_Check(py_obj) ) {
+		json_int(b, PyInt_AsLong(py_obj));
+	}
+	else if ( PyLong_Check(py_obj) ) {
+		// Integers of any size are valid JSON
+		PyObject * py_str = PyObject_Str(py_obj);
+		json_raw(b, PyString_AS_STRING(py_str), (size_t) PyString_GET_SIZE(py_str));
+		Py_DECREF(py_str);
+	}
+	else if ( PyFloat_Check(py_obj) ) {
+		json_double(b, PyFloat_AsDouble(py_obj));
+	}
+	else if ( PyString_Check(py_obj) ) {
+		json_string(b, PyString_AS_STRING(py_obj), (size_t) PyString_GET_SIZE(py_obj));
+	}
+	else if ( PyUnicode_Check(py_obj) ) {
+		PyObject * py_utf8 = PyUnicode_AsUTF8String(py_obj);
+		if ( py_utf8 == NULL ) {
+			PyErr_Clear();
+			as_error_update(j->err, AEROSPIKE_ERR_CLIENT, "unicode value can not be encoded as UTF-8");
+			return false;
+		}
+		json_string(b, PyString_AS_STRING(py_utf8), (size_t) PyString_GET_SIZE(py_utf8));
+		Py_DECREF(py_utf8);
+	}
+	else if ( PyList_Check(py_obj) || PyTuple_Check(py_obj) || PyDict_Check(py_obj) ) {
+		if ( j->depth >= JSON_MAX_DEPTH ) {
+			as_error_update(j->err, AEROSPIKE_ERR_CLIENT, "value is nested too deeply to encode as JSON");
+			return false;
+		}
+
+		j->depth++;
+		if ( PyDict_Check(py_obj) ) {
+			PyObject * py_key = NULL;
+			PyObject * py_val = NULL;
+			Py_ssize_t pos = 0;
+			json_raw(b, "{", 1);
+			for ( bool first = true; PyDict_Next(py_obj, &pos, &py_key, &py_val); first = false ) {
+				if ( ! first ) {
+					json_raw(b, ",", 1);
+				}
+				if ( ! json_pykey(j, py_key) ) {
+					break;
+				}
+				json_raw(b, ":", 1);
+				if ( ! json_pyobject(j, py_val) ) {
+					break;
+				}
+			}
+			json_raw(b, "}", 1);
+		}
+		else {
+			PyObject * py_seq = PySequence_Fast(py_obj, "value must be a list or tuple");
+			Py_ssize_t size = PySequence_Fast_GET_SIZE(py_seq);
+			PyObject ** py_items = PySequence_Fast_ITEMS(py_seq);
+			json_raw(b, "[", 1);
+			for ( Py_ssize_t i = 0; i < size; i++ ) {
+				if ( i > 0 ) {
+					json_raw(b, ",", 1);
+				}
+				if ( ! json_pyobject(j, py_items[i]) ) {
+					break;
+				}
+			}
+			json_raw(b, "]", 1);
+			Py_DECREF(py_seq);
+		}
+		j->depth--;
+	}
+	else if ( PyObject_CheckBuffer(py_obj) ) {
+		// bytearray, and the views of bytes bins
+		Py_buffer view;
+		if ( PyObject_GetBuffer(py_obj, &view, PyBUF_SIMPLE) != 0 ) {
+			PyErr_Clear();
+			as_error_update(j->err, AEROSPIKE_ERR_CLIENT, "value of type %s does not export a contiguous buffer", Py_TYPE(py_obj)->tp_name);
+			return false;
+		}
+		json_base64(b, (const uint8_t *) view.buf, (size_t) view.len);
+		PyBuffer_Release(&view);
+	}
+	else {
+		as_error_update(j->err, AEROSPIKE_ERR_CLIENT, "value of type %s can not be encoded as JSON", Py_TYPE(py_obj)->tp_name);
+		return false;
+	}
+
+	return j->err->code == AEROSPIKE_OK;
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+static as_status json_finish(as_error * err, json_buffer * b, char ** data, size_t * size)
+{
+	if ( err->code != AEROSPIKE_OK ) {
+		free(b->data);
+		return err->code;
+	}
+
+	*data = b->data;
+	*size = b->size;
+	return err->code;
+}
+
+as_status json_encode_record(as_error * err, const as_record * rec, bool decompress, char ** data, size_t * size)
+{
+	as_error_reset(err);
+
+	json_buffer b = { NULL, 0, 0 };
+	json_data j = { &b, err, 0, true, decompress };
+
+	json_raw(&b, "{", 1);
+	for ( uint16_t i = 0; i < rec->bins.size; i++ ) {
+		const as_bin * bin = &rec->bins.entries[i];
+		if ( bin->valuep == NULL ) {
+			continue;
+		}
+		json_next(&j);
+		json_string(&b, bin->name, strlen(bin->name));
+		json_raw(&b, ":", 1);
+		if ( ! json_val(&j, (const as_val *) bin->valuep) ) {
+			break;
+		}
+	}
+	json_raw(&b, "}", 1);
+
+	return json_finish(err, &b, data, size);
+}
+
+as_status json_encode_pyobject(as_error * err, PyObject * py_obj, char ** data, size_t * size)
+{
+	as_error_reset(err);
+
+	json_buffer b = { NULL, 0, 0 };
+	json_data j = { &b, err, 0, true, false };
+
+	json_pyobject(&j, py_obj);
+
+	return json_finish(err, &b, data, size);
+}
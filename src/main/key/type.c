@@ -48,7 +48,8 @@ static PyMethodDef AerospikeKey_Type_Methods[] = {
     {"remove",	(PyCFunction) AerospikeKey_Remove,	METH_VARARGS | METH_KEYWORDS,
     			"Remove a record."},
     
-    // {"select",	(PyCFunction) AerospikeKey_Select,	METH_VARARGS | METH_KEYWORDS, "Select specific bins of the record."},
+    {"select",	(PyCFunction) AerospikeKey_Select,	METH_VARARGS | METH_KEYWORDS,
+    			"Select specific bins of the record."},
 	
 	{NULL}
 };
@@ -0,0 +1,525 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <aerospike/as_error.h>
+
+#include "packer.h"
+
+/*******************************************************************************
+ * ENCODER
+ ******************************************************************************/
+
+uint8_t * pack_reserve(pack_buffer * b, size_t n)
+{
+	if ( b->size + n > b->capacity ) {
+		size_t capacity = b->capacity ? b->capacity * 2 : 256;
+		while ( capacity < b->size + n ) {
+			capacity *= 2;
+		}
+		b->data = (uint8_t *) realloc(b->data, capacity);
+		b->capacity = capacity;
+	}
+	uint8_t * p = b->data + b->size;
+	b->size += n;
+	return p;
+}
+
+static void pack_u8(pack_buffer * b, uint8_t v)
+{
+	*pack_reserve(b, 1) = v;
+}
+
+static void pack_be(pack_buffer * b, uint8_t marker, uint64_t v, int n)
+{
+	uint8_t * p = pack_reserve(b, 1 + n);
+	p[0] = marker;
+	for ( int i = n; i > 0; i-- ) {
+		p[i] = (uint8_t) v;
+		v >>= 8;
+	}
+}
+
+static void pack_raw(pack_buffer * b, const void * data, size_t size)
+{
+	if ( size > 0 ) {
+		memcpy(pack_reserve(b, size), data, size);
+	}
+}
+
+/**
+ * Writes the header of a sized type: the fixed marker when the size fits in
+ * the marker, and the 8, 16 or 32 bit marker otherwise. A marker of 0 means
+ * the type has no such form.
+ */
+static void pack_header(pack_buffer * b, uint8_t fix, size_t fix_max, uint8_t m8, uint8_t m16, uint8_t m32, size_t size)
+{
+	if ( fix && size <= fix_max )			pack_u8(b, fix | (uint8_t) size);
+	else if ( m8 && size <= UINT8_MAX )		pack_be(b, m8, size, 1);
+	else if ( size <= UINT16_MAX )			pack_be(b, m16, size, 2);
+	else									pack_be(b, m32, size, 4);
+}
+
+void pack_nil(pack_buffer * b)
+{
+	pack_u8(b, 0xc0);
+}
+
+void pack_int(pack_buffer * b, int64_t v)
+{
+	if ( v >= 0 ) {
+		if ( v < 128 )					pack_u8(b, (uint8_t) v);
+		else if ( v <= UINT8_MAX )		pack_be(b, 0xcc, v, 1);
+		else if ( v <= UINT16_MAX )		pack_be(b, 0xcd, v, 2);
+		else if ( v <= UINT32_MAX )		pack_be(b, 0xce, v, 4);
+		else							pack_be(b, 0xcf, v, 8);
+	}
+	else {
+		if ( v >= -32 )					pack_u8(b, (uint8_t) v);
+		else if ( v >= INT8_MIN )		pack_be(b, 0xd0, (uint64_t) v, 1);
+		else if ( v >= INT16_MIN )		pack_be(b, 0xd1, (uint64_t) v, 2);
+		else if ( v >= INT32_MIN )		pack_be(b, 0xd2, (uint64_t) v, 4);
+		else							pack_be(b, 0xd3, (uint64_t) v, 8);
+	}
+}
+
+void pack_double(pack_buffer * b, double d)
+{
+	uint64_t bits;
+	memcpy(&bits, &d, sizeof(bits));
+	pack_be(b, 0xcb, bits, 8);
+}
+
+void pack_str(pack_buffer * b, const char * data, size_t size)
+{
+	pack_header(b, 0xa0, 31, 0xd9, 0xda, 0xdb, size);
+	pack_raw(b, data, size);
+}
+
+void pack_bin(pack_buffer * b, const uint8_t * data, size_t size)
+{
+	pack_header(b, 0, 0, 0xc4, 0xc5, 0xc6, size);
+	pack_raw(b, data, size);
+}
+
+void pack_ext(pack_buffer * b, int8_t type, const uint8_t * data, size_t size)
+{
+	pack_header(b, 0, 0, 0xc7, 0xc8, 0xc9, size);
+	pack_u8(b, (uint8_t) type);
+	pack_raw(b, data, size);
+}
+
+void pack_array_header(pack_buffer * b, size_t size)
+{
+	pack_header(b, 0x90, 15, 0, 0xdc, 0xdd, size);
+}
+
+void pack_map_header(pack_buffer * b, size_t size)
+{
+	pack_header(b, 0x80, 15, 0, 0xde, 0xdf, size);
+}
+
+as_status pack_pyobject(as_error * err, pack_buffer * b, PyObject * py_obj, int depth)
+{
+	if ( depth > PACK_MAX_DEPTH ) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "value is nested too deeply to serialize");
+	}
+
+	if ( py_obj == Py_None ) {
+		pack_nil(b);
+	}
+	else if ( py_obj == Py_True || py_obj == Py_False ) {
+		pack_u8(b, py_obj == Py_True ? 0xc3 : 0xc2);
+	}
+	else if ( PyInt_Check(py_obj) ) {
+		pack_int(b, PyInt_AsLong(py_obj));
+	}
+	else if ( PyLong_Check(py_obj) ) {
+		int64_t v = PyLong_AsLongLong(py_obj);
+		if ( v == -1 && PyErr_Occurred() ) {
+			PyErr_Clear();
+			uint64_t u = PyLong_AsUnsignedLongLong(py_obj);
+			if ( u == (uint64_t) -1 && PyErr_Occurred() ) {
+				PyErr_Clear();
+				return as_error_update(err, AEROSPIKE_ERR_PARAM, "integer value exceeds 64 bits");
+			}
+			pack_be(b, 0xcf, u, 8);
+		}
+		else {
+			pack_int(b, v);
+		}
+	}
+	else if ( PyFloat_Check(py_obj) ) {
+		pack_double(b, PyFloat_AsDouble(py_obj));
+	}
+	else if ( PyString_Check(py_obj) ) {
+		pack_str(b, PyString_AS_STRING(py_obj), (size_t) PyString_GET_SIZE(py_obj));
+	}
+	else if ( PyUnicode_Check(py_obj) ) {
+		// Stored as UTF-8, and read back as str
+		PyObject * py_utf8 = PyUnicode_AsUTF8String(py_obj);
+		if ( py_utf8 == NULL ) {
+			PyErr_Clear();
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "unicode value can not be encoded as UTF-8");
+		}
+		pack_str(b, PyString_AS_STRING(py_utf8), (size_t) PyString_GET_SIZE(py_utf8));
+		Py_DECREF(py_utf8);
+	}
+	else if ( PyByteArray_Check(py_obj) ) {
+		pack_bin(b, (const uint8_t *) PyByteArray_AS_STRING(py_obj), (size_t) PyByteArray_GET_SIZE(py_obj));
+	}
+	else if ( PyList_Check(py_obj) || PyTuple_Check(py_obj) ) {
+		// Tuples are read back as lists
+		PyObject * py_seq = PySequence_Fast(py_obj, "value must be a list or tuple");
+		Py_ssize_t size = PySequence_Fast_GET_SIZE(py_seq);
+		PyObject ** py_items = PySequence_Fast_ITEMS(py_seq);
+		pack_array_header(b, (size_t) size);
+		for ( Py_ssize_t i = 0; i < size && err->code == AEROSPIKE_OK; i++ ) {
+			pack_pyobject(err, b, py_items[i], depth + 1);
+		}
+		Py_DECREF(py_seq);
+	}
+	else if ( PyDict_Check(py_obj) ) {
+		PyObject * py_key = NULL;
+		PyObject * py_val = NULL;
+		Py_ssize_t pos = 0;
+		pack_map_header(b, (size_t) PyDict_Size(py_obj));
+		while ( err->code == AEROSPIKE_OK && PyDict_Next(py_obj, &pos, &py_key, &py_val) ) {
+			if ( pack_pyobject(err, b, py_key, depth + 1) == AEROSPIKE_OK ) {
+				pack_pyobject(err, b, py_val, depth + 1);
+			}
+		}
+	}
+	else {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "value of type %s can not be serialized with msgpack.", Py_TYPE(py_obj)->tp_name);
+	}
+
+	return err->code;
+}
+
+/*******************************************************************************
+ * DECODER
+ ******************************************************************************/
+
+static bool unpack_need(unpack_reader * r, size_t n)
+{
+	return (size_t) (r->end - r->pos) >= n;
+}
+
+static uint64_t unpack_be(unpack_reader * r, int n)
+{
+	uint64_t v = 0;
+	for ( int i = 0; i < n; i++ ) {
+		v = (v << 8) | r->pos[i];
+	}
+	r->pos += n;
+	return v;
+}
+
+static PyObject * unpack_int(int64_t v)
+{
+	if ( v >= LONG_MIN && v <= LONG_MAX ) {
+		return PyInt_FromLong((long) v);
+	}
+	return PyLong_FromLongLong(v);
+}
+
+static as_status unpack_truncated(as_error * err)
+{
+	return as_error_update(err, AEROSPIKE_ERR_CLIENT, "serialized value is truncated");
+}
+
+/**
+ * Reads the size of a sized type, which follows its marker in the given
+ * number of bytes.
+ */
+static as_status unpack_size(unpack_reader * r, as_error * err, int width, size_t * size)
+{
+	if ( ! unpack_need(r, width) ) {
+		return unpack_truncated(err);
+	}
+	*size = (size_t) unpack_be(r, width);
+	return err->code;
+}
+
+as_status unpack_map_header(unpack_reader * r, as_error * err, size_t * size)
+{
+	if ( ! unpack_need(r, 1) ) {
+		return unpack_truncated(err);
+	}
+
+	uint8_t marker = *r->pos++;
+
+	if ( marker >= 0x80 && marker <= 0x8f ) {
+		*size = marker & 0x0f;
+		return err->code;
+	}
+	if ( marker == 0xde || marker == 0xdf ) {
+		return unpack_size(r, err, marker == 0xde ? 2 : 4, size);
+	}
+
+	return as_error_update(err, AEROSPIKE_ERR_CLIENT, "serialized value is not a map");
+}
+
+as_status unpack_str(unpack_reader * r, as_error * err, const char ** data, size_t * size)
+{
+	if ( ! unpack_need(r, 1) ) {
+		return unpack_truncated(err);
+	}
+
+	uint8_t marker = *r->pos++;
+
+	if ( marker >= 0xa0 && marker <= 0xbf ) {
+		*size = marker & 0x1f;
+	}
+	else if ( marker >= 0xd9 && marker <= 0xdb ) {
+		static const int widths[] = { 1, 2, 4 };
+		if ( unpack_size(r, err, widths[marker - 0xd9], size) != AEROSPIKE_OK ) {
+			return err->code;
+		}
+	}
+	else {
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "serialized value is not a string");
+	}
+
+	if ( ! unpack_need(r, *size) ) {
+		return unpack_truncated(err);
+	}
+
+	*data = (const char *) r->pos;
+	r->pos += *size;
+
+	return err->code;
+}
+
+as_status unpack_uint(unpack_reader * r, as_error * err, uint64_t * v)
+{
+	if ( ! unpack_need(r, 1) ) {
+		return unpack_truncated(err);
+	}
+
+	uint8_t marker = *r->pos++;
+
+	if ( marker <= 0x7f ) {
+		*v = marker;
+		return err->code;
+	}
+	if ( marker >= 0xcc && marker <= 0xcf ) {
+		int n = 1 << (marker - 0xcc);
+		if ( ! unpack_need(r, n) ) {
+			return unpack_truncated(err);
+		}
+		*v = unpack_be(r, n);
+		return err->code;
+	}
+
+	return as_error_update(err, AEROSPIKE_ERR_CLIENT, "serialized value is not an unsigned integer");
+}
+
+static as_status unpack_array(unpack_reader * r, as_error * err, size_t size, PyObject ** py_obj, int depth)
+{
+	// Every element takes at least one byte
+	if ( ! unpack_need(r, size) ) {
+		return unpack_truncated(err);
+	}
+
+	PyObject * py_list = PyList_New((Py_ssize_t) size);
+	for ( size_t i = 0; i < size; i++ ) {
+		PyObject * py_item = NULL;
+		if ( unpack_pyobject(r, err, &py_item, depth + 1) != AEROSPIKE_OK ) {
+			Py_DECREF(py_list);
+			return err->code;
+		}
+		PyList_SET_ITEM(py_list, (Py_ssize_t) i, py_item);
+	}
+
+	*py_obj = py_list;
+	return err->code;
+}
+
+static as_status unpack_map(unpack_reader * r, as_error * err, size_t size, PyObject ** py_obj, int depth)
+{
+	// Every entry takes at least two bytes
+	if ( ! unpack_need(r, size * 2) ) {
+		return unpack_truncated(err);
+	}
+
+	PyObject * py_dict = _PyDict_NewPresized((Py_ssize_t) size);
+	for ( size_t i = 0; i < size; i++ ) {
+		PyObject * py_key = NULL;
+		PyObject * py_val = NULL;
+		if ( unpack_pyobject(r, err, &py_key, depth + 1) != AEROSPIKE_OK ) {
+			break;
+		}
+		py_key = unpack_map_key(py_key);
+		if ( unpack_pyobject(r, err, &py_val, depth + 1) != AEROSPIKE_OK ) {
+			Py_DECREF(py_key);
+			break;
+		}
+		if ( PyDict_SetItem(py_dict, py_key, py_val) != 0 ) {
+			// Keys which are not hashable are skipped
+			PyErr_Clear();
+		}
+		Py_DECREF(py_key);
+		Py_DECREF(py_val);
+		if ( err->code != AEROSPIKE_OK ) {
+			break;
+		}
+	}
+
+	if ( err->code != AEROSPIKE_OK ) {
+		Py_DECREF(py_dict);
+		return err->code;
+	}
+
+	*py_obj = py_dict;
+	return err->code;
+}
+
+PyObject * unpack_map_key(PyObject * py_key)
+{
+	if ( ! PyByteArray_CheckExact(py_key) ) {
+		return py_key;
+	}
+	PyObject * py_str = PyString_FromStringAndSize(PyByteArray_AS_STRING(py_key), PyByteArray_GET_SIZE(py_key));
+	Py_DECREF(py_key);
+	return py_str;
+}
+
+as_status unpack_pyobject(unpack_reader * r, as_error * err, PyObject ** py_obj, int depth)
+{
+	if ( depth > PACK_MAX_DEPTH ) {
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "serialized value is nested too deeply");
+	}
+
+	if ( ! unpack_need(r, 1) ) {
+		return unpack_truncated(err);
+	}
+
+	uint8_t marker = *r->pos++;
+
+	// The size of the sized types, and the width of the fixed width types
+	size_t size = 0;
+	int width = 0;
+
+	switch ( marker ) {
+		case 0xc0: Py_INCREF(Py_None);  *py_obj = Py_None;  return err->code;
+		case 0xc2: Py_INCREF(Py_False); *py_obj = Py_False; return err->code;
+		case 0xc3: Py_INCREF(Py_True);  *py_obj = Py_True;  return err->code;
+		case 0xc4: case 0xc7: case 0xd9: width = 1; break;
+		case 0xc5: case 0xc8: case 0xda: case 0xdc: case 0xde: width = 2; break;
+		case 0xc6: case 0xc9: case 0xdb: case 0xdd: case 0xdf: width = 4; break;
+		case 0xd4: size = 1; break;
+		case 0xd5: size = 2; break;
+		case 0xd6: size = 4; break;
+		case 0xd7: size = 8; break;
+		case 0xd8: size = 16; break;
+		case 0xca: case 0xcb:
+		case 0xcc: case 0xcd: case 0xce: case 0xcf:
+		case 0xd0: case 0xd1: case 0xd2: case 0xd3: {
+			static const int widths[] = { 4, 8, 1, 2, 4, 8, 1, 2, 4, 8 };
+			int n = widths[marker - 0xca];
+			if ( ! unpack_need(r, n) ) {
+				return unpack_truncated(err);
+			}
+			uint64_t v = unpack_be(r, n);
+			if ( marker == 0xca ) {
+				uint32_t bits = (uint32_t) v;
+				float f;
+				memcpy(&f, &bits, sizeof(f));
+				*py_obj = PyFloat_FromDouble(f);
+			}
+			else if ( marker == 0xcb ) {
+				double d;
+				memcpy(&d, &v, sizeof(d));
+				*py_obj = PyFloat_FromDouble(d);
+			}
+			else if ( marker <= 0xcf ) {
+				*py_obj = v > INT64_MAX ? PyLong_FromUnsignedLongLong(v) : unpack_int((int64_t) v);
+			}
+			else {
+				// Sign extend from the width of the value
+				int shift = 64 - n * 8;
+				*py_obj = unpack_int(((int64_t) (v << shift)) >> shift);
+			}
+			return err->code;
+		}
+		default: {
+			if ( marker <= 0x7f ) {
+				*py_obj = PyInt_FromLong(marker);
+				return err->code;
+			}
+			if ( marker >= 0xe0 ) {
+				*py_obj = PyInt_FromLong((int8_t) marker);
+				return err->code;
+			}
+			if ( marker >= 0x80 && marker <= 0x8f ) {
+				return unpack_map(r, err, marker & 0x0f, py_obj, depth);
+			}
+			if ( marker >= 0x90 && marker <= 0x9f ) {
+				return unpack_array(r, err, marker & 0x0f, py_obj, depth);
+			}
+			if ( marker >= 0xa0 && marker <= 0xbf ) {
+				size = marker & 0x1f;
+				marker = 0xd9;
+				break;
+			}
+			return as_error_update(err, AEROSPIKE_ERR_CLIENT, "serialized value has an unsupported msgpack type 0x%02x", marker);
+		}
+	}
+
+	if ( width && unpack_size(r, err, width, &size) != AEROSPIKE_OK ) {
+		return err->code;
+	}
+
+	switch ( marker ) {
+		case 0xdc: case 0xdd:
+			return unpack_array(r, err, size, py_obj, depth);
+		case 0xde: case 0xdf:
+			return unpack_map(r, err, size, py_obj, depth);
+	}
+
+	bool ext = (marker >= 0xc7 && marker <= 0xc9) || (marker >= 0xd4 && marker <= 0xd8);
+
+	if ( ! unpack_need(r, size + (ext ? 1 : 0)) ) {
+		return unpack_truncated(err);
+	}
+
+	if ( ext ) {
+		int8_t type = (int8_t) *r->pos++;
+		const uint8_t * data = r->pos;
+		r->pos += size;
+		if ( r->ext == NULL ) {
+			return as_error_update(err, AEROSPIKE_ERR_CLIENT, "serialized value has an unsupported msgpack ext type %d", type);
+		}
+		return r->ext(r, err, type, data, (uint32_t) size, py_obj);
+	}
+
+	if ( marker >= 0xc4 && marker <= 0xc6 ) {
+		*py_obj = PyByteArray_FromStringAndSize((const char *) r->pos, (Py_ssize_t) size);
+	}
+	else {
+		*py_obj = PyString_FromStringAndSize((const char *) r->pos, (Py_ssize_t) size);
+	}
+	r->pos += size;
+
+	return err->code;
+}
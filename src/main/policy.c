@@ -19,6 +19,7 @@
 
 #include <aerospike/as_error.h>
 #include <aerospike/as_policy.h>
+#include <aerospike/as_scan.h>
 #include <aerospike/as_status.h>
 
 #include "policy.h"
@@ -79,6 +80,28 @@ as_status pyobject_to_policy_apply(as_error * err, PyObject * py_policy,
 	return err->code;
 }
 
+/**
+ * Converts a PyObject into an as_policy_batch object.
+ * Returns AEROSPIKE_OK on success. On error, the err argument is populated.
+ * We assume that the error object and the policy object are already allocated
+ * and initialized (although, we do reset the error object here).
+ */
+as_status pyobject_to_policy_batch(as_error * err, PyObject * py_policy,
+									as_policy_batch * policy,
+									as_policy_batch ** policy_p)
+{
+	// Initialize Policy
+	POLICY_INIT(as_policy_batch);
+
+	// Set policy fields
+	POLICY_SET_FIELD(timeout, uint32_t);
+
+	// Update the policy
+	POLICY_UPDATE();
+
+	return err->code;
+}
+
 /**
  * Converts a PyObject into an as_policy_info object.
  * Returns AEROSPIKE_OK on success. On error, the err argument is populated.
@@ -103,6 +126,31 @@ as_status pyobject_to_policy_info(as_error * err, PyObject * py_policy,
 	return err->code;
 }
 
+/**
+ * Converts a PyObject into an as_policy_operate object.
+ * Returns AEROSPIKE_OK on success. On error, the err argument is populated.
+ * We assume that the error object and the policy object are already allocated
+ * and initialized (although, we do reset the error object here).
+ */
+as_status pyobject_to_policy_operate(as_error * err, PyObject * py_policy,
+									as_policy_operate * policy,
+									as_policy_operate ** policy_p)
+{
+	// Initialize Policy
+	POLICY_INIT(as_policy_operate);
+
+	// Set policy fields
+	POLICY_SET_FIELD(timeout, uint32_t);
+	POLICY_SET_FIELD(retry, as_policy_retry);
+	POLICY_SET_FIELD(key, as_policy_key);
+	POLICY_SET_FIELD(gen, as_policy_gen);
+
+	// Update the policy
+	POLICY_UPDATE();
+
+	return err->code;
+}
+
 /**
  * Converts a PyObject into an as_policy_query object.
  * Returns AEROSPIKE_OK on success. On error, the err argument is populated.
@@ -197,6 +245,60 @@ as_status pyobject_to_policy_scan(as_error * err, PyObject * py_policy,
 	return err->code;
 }
 
+/**
+ * Applies the options of a scan, from a dict with the optional 'priority',
+ * 'percent', 'nobins' and 'concurrent' keys.
+ * Returns AEROSPIKE_OK on success. On error, the err argument is populated.
+ */
+as_status pyobject_to_scan_options(as_error * err, PyObject * py_options, as_scan * scan)
+{
+	as_error_reset(err);
+
+	if ( ! py_options || py_options == Py_None ) {
+		return err->code;
+	}
+
+	if ( ! PyDict_Check(py_options) ) {
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "options must be a dict");
+	}
+
+	PyObject * py_priority = PyDict_GetItemString(py_options, "priority");
+	if ( py_priority ) {
+		long priority = PyInt_Check(py_priority) ? PyInt_AsLong(py_priority) : -1;
+		if ( priority < AS_SCAN_PRIORITY_AUTO || priority > AS_SCAN_PRIORITY_HIGH ) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "priority must be one of the aerospike.SCAN_PRIORITY_* constants");
+		}
+		as_scan_set_priority(scan, (as_scan_priority) priority);
+	}
+
+	PyObject * py_percent = PyDict_GetItemString(py_options, "percent");
+	if ( py_percent ) {
+		long percent = PyInt_Check(py_percent) ? PyInt_AsLong(py_percent) : -1;
+		if ( percent < 1 || percent > 100 ) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "percent must be an integer from 1 to 100");
+		}
+		as_scan_set_percent(scan, (uint8_t) percent);
+	}
+
+	PyObject * py_nobins = PyDict_GetItemString(py_options, "nobins");
+	if ( py_nobins ) {
+		if ( ! PyBool_Check(py_nobins) ) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "nobins must be a bool");
+		}
+		as_scan_set_nobins(scan, py_nobins == Py_True);
+	}
+
+	PyObject * py_concurrent = PyDict_GetItemString(py_options, "concurrent");
+	if ( py_concurrent ) {
+		if ( ! PyBool_Check(py_concurrent) ) {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "concurrent must be a bool");
+		}
+		as_scan_set_concurrent(scan, py_concurrent == Py_True);
+	}
+
+	return err->code;
+}
+
 /**
  * Converts a PyObject into an as_policy_write object.
  * Returns AEROSPIKE_OK on success. On error, the err argument is populated.
@@ -222,3 +324,42 @@ as_status pyobject_to_policy_write(as_error * err, PyObject * py_policy,
 
 	return err->code;
 }
+
+/**
+ * Converts the compression fields of a client config or write policy dict.
+ * Fields which are not set keep their defaults.
+ */
+as_status pyobject_to_compression(as_error * err, PyObject * py_dict,
+									const compression * defaults,
+									compression * c)
+{
+	as_error_reset(err);
+
+	*c = *defaults;
+
+	if ( ! py_dict || ! PyDict_Check(py_dict) ) {
+		return err->code;
+	}
+
+	PyObject * py_threshold = PyDict_GetItemString(py_dict, "compress_threshold");
+	if ( py_threshold ) {
+		if ( PyInt_Check(py_threshold) && PyInt_AsLong(py_threshold) >= 0 && PyInt_AsLong(py_threshold) <= UINT32_MAX ) {
+			c->threshold = (uint32_t) PyInt_AsLong(py_threshold);
+		}
+		else {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "compress_threshold is invalid");
+		}
+	}
+
+	PyObject * py_level = PyDict_GetItemString(py_dict, "compress_level");
+	if ( py_level ) {
+		if ( PyInt_Check(py_level) && PyInt_AsLong(py_level) >= COMPRESSION_LEVEL_DEFAULT && PyInt_AsLong(py_level) <= COMPRESSION_LEVEL_MAX ) {
+			c->level = (int) PyInt_AsLong(py_level);
+		}
+		else {
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "compress_level is invalid");
+		}
+	}
+
+	return err->code;
+}
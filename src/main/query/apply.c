@@ -68,7 +68,7 @@ AerospikeQuery * AerospikeQuery_Apply(AerospikeQuery * self, PyObject * args, Py
 		for ( int i = 2; i < nargs; i++ ) {
 			PyObject * py_val = PyTuple_GetItem(args, i);
 			as_val * val = NULL;
-			pyobject_to_val(&err, py_val, &val);
+			pyobject_to_val(self->client, &err, py_val, &val, NULL);
 
 			if ( err.code != AEROSPIKE_OK ) {
 				goto CLEANUP;
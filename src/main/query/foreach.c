@@ -22,17 +22,13 @@
 #include <aerospike/as_policy.h>
 #include <aerospike/as_query.h>
 
+#include "cancel.h"
 #include "client.h"
 #include "conversions.h"
 #include "query.h"
 #include "policy.h"
-
-// Struct for Python User-Data for the Callback
-typedef struct {
-	as_error error;
-	PyObject * callback;
-} LocalData;
-
+#include "record.h"
+#include "results.h"
 
 static bool each_result(const as_val * val, void * udata)
 {
@@ -40,37 +36,36 @@ static bool each_result(const as_val * val, void * udata)
 		return false;
 	}
 
-	// Extract callback user-data
-	LocalData * data = (LocalData *) udata;
-	as_error * err = &data->error;
-	PyObject * py_callback = data->callback;
-
-	// Python Function Arguments and Result Value
-	PyObject * py_arglist = NULL; 
-	PyObject * py_result = NULL;
-
-	// Lock Python State
-	PyGILState_STATE gstate;
-	gstate = PyGILState_Ensure();
+	return results_batch_add((results_batch *) udata, val);
+}
 
-	// Convert as_val to a Python Object
-	val_to_pyobject(err, val, &py_result);
+static bool each_batch_result(PyObject * py_result, void * udata)
+{
+	PyObject * py_callback = (PyObject *) udata;
 
-	// Build Python Function Arguments
-	py_arglist = Py_BuildValue("(O)", py_result);
-	
 	// Invoke Python Callback
-	PyEval_CallObject(py_callback, py_arglist);
+	PyObject * py_ret = PyObject_CallFunctionObjArgs(py_callback, py_result, NULL);
+	if ( py_ret == NULL ) {
+		return false;
+	}
 
-	// TODO: handle return value
+	// Returning False stops the query
+	bool more = py_ret != Py_False;
+	Py_DECREF(py_ret);
 
-	// Release Python Function Arguments
-	Py_DECREF(py_arglist);
+	return more;
+}
 
-	// Release Python State
-	PyGILState_Release(gstate);
+typedef struct {
+	AerospikeQuery * self;
+	as_policy_query * policy;
+	results_batch * batch;
+} foreach_data;
 
-	return true;
+static void run_query(as_error * err, void * udata)
+{
+	foreach_data * data = (foreach_data *) udata;
+	aerospike_query_foreach(data->self->client->as, err, data->policy, &data->self->query, each_result, data->batch);
 }
 
 PyObject * AerospikeQuery_Foreach(AerospikeQuery * self, PyObject * args, PyObject * kwds)
@@ -78,12 +73,17 @@ PyObject * AerospikeQuery_Foreach(AerospikeQuery * self, PyObject * args, PyObje
 	// Python Function Arguments
 	PyObject * py_callback = NULL;
 	PyObject * py_policy = NULL;
+	int batch_size = 0;
+	int max_delay_ms = 0;
+	int limit = 0;
+	PyObject * py_cancel = NULL;
 
 	// Python Function Keyword Arguments
-	static char * kwlist[] = {"callback", "policy", NULL};
+	static char * kwlist[] = {"callback", "policy", "batch_size", "max_delay_ms", "limit", "cancel", NULL};
 
 	// Python Function Argument Parsing
-	if ( PyArg_ParseTupleAndKeywords(args, kwds, "O|O:foreach", kwlist, &py_callback, &py_policy) == false ) {
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "O|OiiiO:foreach", kwlist, 
+			&py_callback, &py_policy, &batch_size, &max_delay_ms, &limit, &py_cancel) == false ) {
 		return NULL;
 	}
 
@@ -91,30 +91,54 @@ PyObject * AerospikeQuery_Foreach(AerospikeQuery * self, PyObject * args, PyObje
 	as_error err;
 	as_policy_query policy;
 	as_policy_query * policy_p = NULL;
+	AerospikeCancelToken * cancel = NULL;
 
 	// Initialize error
 	as_error_init(&err);
 
+	if ( batch_size < 0 ) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "batch_size must not be negative");
+		goto CLEANUP;
+	}
+
+	if ( max_delay_ms < 0 ) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "max_delay_ms must not be negative");
+		goto CLEANUP;
+	}
+
+	if ( limit < 0 ) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "limit must not be negative");
+		goto CLEANUP;
+	}
+
+	pyobject_to_cancel_token(&err, py_cancel, &cancel);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+
 	// Convert python policy object to as_policy_exists
 	pyobject_to_policy_query(&err, py_policy, &policy, &policy_p);
 	if ( err.code != AEROSPIKE_OK ) {
 		goto CLEANUP;
 	}
 
-	// Create and initialize callback user-data
-	LocalData data;
-	data.callback = py_callback;
-	as_error_init(&data.error);
+	// Results are handed to the callback in batches, as lists of batch_size
+	// results when given
+	results_batch batch;
+	results_batch_init(&batch, self->client, (uint32_t) batch_size, (uint32_t) max_delay_ms, each_batch_result, py_callback);
+	batch.limit = (uint32_t) limit;
+	batch.cancel = cancel;
 
-	// We are spawning multiple threads
-	PyThreadState * _save = PyEval_SaveThread();
-	
-	// Invoke operation
-	aerospike_query_foreach(self->client->as, &err, policy_p, &self->query, each_result, &data);
+	// Invoke operation on a native thread, while this thread waits for it,
+	// checking for signals and cancellation
+	foreach_data data = { self, policy_p, &batch };
+	results_batch_run(&batch, run_query, &data, &err);
+
+	// Raise the exception of the callback or of a signal handler, if any
+	if ( results_batch_finish(&batch, &err) == false ) {
+		return NULL;
+	}
 
-	// We are done using multiple threads
-	PyEval_RestoreThread(_save);
-	
 CLEANUP:
 
 	if ( err.code != AEROSPIKE_OK ) {
@@ -15,95 +15,58 @@
  ******************************************************************************/
 
 #include <Python.h>
-#include <pthread.h>
 #include <stdbool.h>
 
-#include <aerospike/aerospike_query.h>
 #include <aerospike/as_error.h>
-#include <aerospike/as_query.h>
+#include <aerospike/as_policy.h>
 
+#include "cancel.h"
 #include "client.h"
 #include "conversions.h"
 #include "query.h"
-
-#undef TRACE
-#define TRACE()
-
-static bool each_result(const as_val * val, void * udata)
-{
-	if ( !val ) {
-		return false;
-	}
-
-	PyObject * py_results = (PyObject *) udata;
-	PyObject * py_result = NULL;
-
-	as_error err;
-	
-	TRACE();
-
-	PyGILState_STATE gstate;
-	gstate = PyGILState_Ensure();
-
-	TRACE();
-
-	val_to_pyobject(&err, val, &py_result);
-
-	TRACE();
-
-	if ( py_result ) {
-	
-		TRACE();
-		PyList_Append(py_results, py_result);
-	
-		TRACE();
-		Py_DECREF(py_result);
-	}
-	
-	TRACE();
-
-	PyGILState_Release(gstate);
-
-	TRACE();
-	return true;
-}
+#include "policy.h"
+#include "stream.h"
 
 PyObject * AerospikeQuery_Results(AerospikeQuery * self, PyObject * args, PyObject * kwds)
 {
+	// Python Function Arguments
 	PyObject * py_policy = NULL;
-	
-	static char * kwlist[] = {"policy", NULL};
+	int limit = 0;
+	PyObject * py_cancel = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"policy", "limit", "cancel", NULL};
 
-	if ( PyArg_ParseTupleAndKeywords(args, kwds, "|O:foreach", kwlist, &py_policy) == false ) {
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "|OiO:results", kwlist, 
+			&py_policy, &limit, &py_cancel) == false ) {
 		return NULL;
 	}
 
+	// Aerospike Client Arguments
 	as_error err;
+	as_policy_query policy;
+	as_policy_query * policy_p = NULL;
+	AerospikeCancelToken * cancel = NULL;
+
+	// Initialize error
 	as_error_init(&err);
 
-	TRACE();
-	PyObject * py_results = PyList_New(0);
-	
-	TRACE();
-	PyThreadState * _save = PyEval_SaveThread();
-	
-	TRACE();
-    aerospike_query_foreach(self->client->as, &err, NULL, &self->query, each_result, py_results);
-    
-	TRACE();
-	PyEval_RestoreThread(_save);
-  	
-	TRACE();
+	if ( limit < 0 ) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "limit must not be negative");
+	}
+	else if ( pyobject_to_cancel_token(&err, py_cancel, &cancel) == AEROSPIKE_OK ) {
+		// Convert python policy object to as_policy_query
+		pyobject_to_policy_query(&err, py_policy, &policy, &policy_p);
+	}
+
 	if ( err.code != AEROSPIKE_OK ) {
 		PyObject * py_err = NULL;
 		error_to_pyobject(&err, &py_err);
 		PyErr_SetObject(PyExc_Exception, py_err);
-		TRACE();
 		return NULL;
 	}
 
-	TRACE();
-	return py_results;
+	// Start the query, which streams its results to the iterator
+	return (PyObject *) AerospikeStream_Query(self, policy_p, (uint32_t) limit, cancel);
 }
-
-
@@ -26,6 +26,7 @@
 
 #include "client.h"
 #include "query.h"
+#include "stream.h"
 
 /*******************************************************************************
  * PYTHON TYPE METHODS
@@ -40,7 +41,7 @@ static PyMethodDef AerospikeQuery_Type_Methods[] = {
     			"Iterate over each record in the resultset and call the callback function."},
 
     {"results",	(PyCFunction) AerospikeQuery_Results,	METH_VARARGS | METH_KEYWORDS,
-    			"Return a list of all records in the resultset."},
+    			"Return an iterator over the records in the resultset."},
     
     {"select",	(PyCFunction) AerospikeQuery_Select,	METH_VARARGS | METH_KEYWORDS,
     			"Bins to project in the query."},
@@ -96,6 +97,14 @@ static int AerospikeQuery_Type_Init(AerospikeQuery * self, PyObject * args, PyOb
     return 0;
 }
 
+/**
+ * Iterating a query runs it, as results() does.
+ */
+static PyObject * AerospikeQuery_Type_Iter(AerospikeQuery * self)
+{
+	return (PyObject *) AerospikeStream_Query(self, NULL, 0, NULL);
+}
+
 static void AerospikeQuery_Type_Dealloc(PyObject * self)
 {
     self->ob_type->tp_free((PyObject *) self);
@@ -136,7 +145,7 @@ static PyTypeObject AerospikeQuery_Type = {
     .tp_clear			= 0,
     .tp_richcompare		= 0,
     .tp_weaklistoffset	= 0,
-    .tp_iter			= 0,
+    .tp_iter			= (getiterfunc) AerospikeQuery_Type_Iter,
     .tp_iternext		= 0,
     .tp_methods			= AerospikeQuery_Type_Methods,
     .tp_members			= 0,
@@ -0,0 +1,483 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <structmember.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <aerospike/as_error.h>
+#include <aerospike/as_record.h>
+
+#include "conversions.h"
+#include "intern.h"
+#include "json.h"
+#include "record.h"
+
+/*******************************************************************************
+ * CONVERSION
+ ******************************************************************************/
+
+/**
+ * Returns the converted value of the bin, converting and caching it on first
+ * access. Returns a borrowed reference, or NULL with err populated, or NULL
+ * with err unset when the record has no such bin.
+ */
+static PyObject * AerospikeRecord_Bin(AerospikeRecord * self, const char * name, as_error * err)
+{
+	as_error_reset(err);
+
+	PyObject * py_val = PyDict_GetItemString(self->bins, name);
+	if ( py_val || ! self->rec ) {
+		return py_val;
+	}
+
+	as_val * val = (as_val *) as_record_get(self->rec, name);
+	if ( ! val ) {
+		return NULL;
+	}
+
+	val_to_pyobject_owned(self->client, err, val, self->client->bytes_view ? self->owner : NULL, &py_val);
+	if ( err->code != AEROSPIKE_OK ) {
+		return NULL;
+	}
+
+	PyObject * py_name = intern_table_get(self->client->bin_names, name);
+	PyDict_SetItem(self->bins, py_name, py_val);
+	Py_DECREF(py_name);
+	Py_DECREF(py_val);
+
+	return py_val;
+}
+
+/**
+ * Converts the remaining bins, then releases the record, as nothing will
+ * refer to it anymore, apart from the bytes views.
+ */
+static PyObject * AerospikeRecord_Bins(AerospikeRecord * self)
+{
+	as_error err;
+	as_error_init(&err);
+
+	if ( self->rec ) {
+		const as_bins * bins = &self->rec->bins;
+
+		for ( uint16_t i = 0; i < bins->size && err.code == AEROSPIKE_OK; i++ ) {
+			AerospikeRecord_Bin(self, bins->entries[i].name, &err);
+		}
+
+		if ( err.code != AEROSPIKE_OK ) {
+			PyObject * py_err = NULL;
+			error_to_pyobject(&err, &py_err);
+			PyErr_SetObject(PyExc_Exception, py_err);
+			return NULL;
+		}
+
+		self->rec = NULL;
+		Py_CLEAR(self->owner);
+	}
+
+	return self->bins;
+}
+
+/*******************************************************************************
+ * PYTHON TYPE METHODS
+ ******************************************************************************/
+
+PyObject * AerospikeRecord_Get(AerospikeRecord * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Arguments
+	char * name = NULL;
+	PyObject * py_default = Py_None;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"bin", "default", NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "s|O:get", kwlist, &name, &py_default) == false ) {
+		return NULL;
+	}
+
+	as_error err;
+	PyObject * py_val = AerospikeRecord_Bin(self, name, &err);
+
+	if ( err.code != AEROSPIKE_OK ) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyErr_SetObject(PyExc_Exception, py_err);
+		return NULL;
+	}
+
+	if ( ! py_val ) {
+		py_val = py_default;
+	}
+
+	Py_INCREF(py_val);
+	return py_val;
+}
+
+PyObject * AerospikeRecord_To_Json(AerospikeRecord * self, PyObject * args, PyObject * kwds)
+{
+	as_error err;
+	char * json = NULL;
+	size_t json_size = 0;
+
+	if ( self->rec ) {
+		// Encode from the record, which the owner keeps alive while the GIL 
+		// is released, even if the bins are converted meanwhile.
+		const as_record * rec = self->rec;
+		PyObject * py_owner = self->owner;
+		Py_INCREF(py_owner);
+
+		PyThreadState * _save = PyEval_SaveThread();
+		json_encode_record(&err, rec, self->client->decompress, &json, &json_size);
+		PyEval_RestoreThread(_save);
+
+		Py_DECREF(py_owner);
+	}
+	else {
+		json_encode_pyobject(&err, self->bins, &json, &json_size);
+	}
+
+	if ( err.code != AEROSPIKE_OK ) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyErr_SetObject(PyExc_Exception, py_err);
+		return NULL;
+	}
+
+	PyObject * py_json = PyString_FromStringAndSize(json, (Py_ssize_t) json_size);
+	free(json);
+	return py_json;
+}
+
+static PyMethodDef AerospikeRecord_Type_Methods[] = {
+
+    {"get",		(PyCFunction) AerospikeRecord_Get,	METH_VARARGS | METH_KEYWORDS,
+    			"Return the value of a bin, or the default if the record has no such bin."},
+
+    {"to_json",	(PyCFunction) AerospikeRecord_To_Json,	METH_VARARGS | METH_KEYWORDS,
+    			"Return the bins of the record as a UTF-8 JSON string."},
+
+	{NULL}
+};
+
+static PyObject * AerospikeRecord_Type_GetKey(AerospikeRecord * self, void * closure)
+{
+	Py_INCREF(self->key);
+	return self->key;
+}
+
+static PyObject * AerospikeRecord_Type_GetMeta(AerospikeRecord * self, void * closure)
+{
+	Py_INCREF(self->meta);
+	return self->meta;
+}
+
+static PyObject * AerospikeRecord_Type_GetBins(AerospikeRecord * self, void * closure)
+{
+	PyObject * py_bins = AerospikeRecord_Bins(self);
+	Py_XINCREF(py_bins);
+	return py_bins;
+}
+
+static PyGetSetDef AerospikeRecord_Type_GetSet[] = {
+	{"key",		(getter) AerospikeRecord_Type_GetKey,	NULL, "The key of the record.", NULL},
+	{"meta",	(getter) AerospikeRecord_Type_GetMeta,	NULL, "The metadata of the record.", NULL},
+	{"bins",	(getter) AerospikeRecord_Type_GetBins,	NULL, "All bins of the record, as a dict.", NULL},
+	{NULL}
+};
+
+/*******************************************************************************
+ * PYTHON SEQUENCE & MAPPING PROTOCOLS
+ ******************************************************************************/
+
+/**
+ * The record behaves as a (key, meta, bins) tuple, so existing code which
+ * unpacks the results keeps working.
+ */
+static Py_ssize_t AerospikeRecord_Type_Length(AerospikeRecord * self)
+{
+	return 3;
+}
+
+static PyObject * AerospikeRecord_Type_Item(AerospikeRecord * self, Py_ssize_t i)
+{
+	switch ( i ) {
+		case 0:
+			return AerospikeRecord_Type_GetKey(self, NULL);
+		case 1:
+			return AerospikeRecord_Type_GetMeta(self, NULL);
+		case 2:
+			return AerospikeRecord_Type_GetBins(self, NULL);
+		default:
+			PyErr_SetString(PyExc_IndexError, "record index out of range");
+			return NULL;
+	}
+}
+
+static PySequenceMethods AerospikeRecord_Type_Sequence = {
+	.sq_length			= (lenfunc) AerospikeRecord_Type_Length,
+	.sq_item			= (ssizeargfunc) AerospikeRecord_Type_Item
+};
+
+/**
+ * record[0..2] index the tuple, while record["name"] reads a single bin.
+ */
+static PyObject * AerospikeRecord_Type_Subscript(AerospikeRecord * self, PyObject * py_name)
+{
+	if ( PyIndex_Check(py_name) ) {
+		Py_ssize_t i = PyNumber_AsSsize_t(py_name, PyExc_IndexError);
+		if ( i == -1 && PyErr_Occurred() ) {
+			return NULL;
+		}
+		return AerospikeRecord_Type_Item(self, i < 0 ? i + 3 : i);
+	}
+
+	if ( ! PyString_Check(py_name) ) {
+		PyErr_SetString(PyExc_TypeError, "A bin name must be a string.");
+		return NULL;
+	}
+
+	as_error err;
+	PyObject * py_val = AerospikeRecord_Bin(self, PyString_AsString(py_name), &err);
+
+	if ( err.code != AEROSPIKE_OK ) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyErr_SetObject(PyExc_Exception, py_err);
+		return NULL;
+	}
+
+	if ( ! py_val ) {
+		PyErr_SetObject(PyExc_KeyError, py_name);
+		return NULL;
+	}
+
+	Py_INCREF(py_val);
+	return py_val;
+}
+
+static PyMappingMethods AerospikeRecord_Type_Mapping = {
+	.mp_length			= (lenfunc) AerospikeRecord_Type_Length,
+	.mp_subscript		= (binaryfunc) AerospikeRecord_Type_Subscript,
+	.mp_ass_subscript	= 0
+};
+
+/*******************************************************************************
+ * PYTHON TYPE HOOKS
+ ******************************************************************************/
+
+static PyObject * AerospikeRecord_Type_Repr(AerospikeRecord * self)
+{
+	PyObject * py_bins = AerospikeRecord_Bins(self);
+	if ( ! py_bins ) {
+		return NULL;
+	}
+
+	PyObject * py_tuple = PyTuple_Pack(3, self->key, self->meta, py_bins);
+	PyObject * py_repr = PyObject_Repr(py_tuple);
+	Py_DECREF(py_tuple);
+	return py_repr;
+}
+
+static void AerospikeRecord_Type_Dealloc(AerospikeRecord * self)
+{
+	Py_XDECREF(self->key);
+	Py_XDECREF(self->meta);
+	Py_XDECREF(self->bins);
+	Py_XDECREF(self->owner);
+	Py_XDECREF(self->client);
+    self->ob_type->tp_free((PyObject *) self);
+}
+
+/*******************************************************************************
+ * PYTHON TYPE DESCRIPTOR
+ ******************************************************************************/
+
+static PyTypeObject AerospikeRecord_Type = {
+	PyObject_HEAD_INIT(NULL)
+
+    .ob_size			= 0,
+    .tp_name			= "aerospike.Record",
+    .tp_basicsize		= sizeof(AerospikeRecord),
+    .tp_itemsize		= 0,
+    .tp_dealloc			= (destructor) AerospikeRecord_Type_Dealloc,
+    .tp_print			= 0,
+    .tp_getattr			= 0,
+    .tp_setattr			= 0,
+    .tp_compare			= 0,
+    .tp_repr			= (reprfunc) AerospikeRecord_Type_Repr,
+    .tp_as_number		= 0,
+    .tp_as_sequence		= &AerospikeRecord_Type_Sequence,
+    .tp_as_mapping		= &AerospikeRecord_Type_Mapping,
+    .tp_hash			= 0,
+    .tp_call			= 0,
+    .tp_str				= 0,
+    .tp_getattro		= 0,
+    .tp_setattro		= 0,
+    .tp_as_buffer		= 0,
+    .tp_flags			= Py_TPFLAGS_DEFAULT,
+    .tp_doc				= 
+    		"The Record class holds a record read from the database, returned\n"
+    		"in place of a (key, meta, bins) tuple when the client is configured\n"
+    		"with 'lazy_records'. A bin is converted when it is first accessed.\n"
+    		"The record unpacks like the tuple:\n"
+    		"\n"
+    		"    (key, meta, bins) = record\n",
+    .tp_traverse		= 0,
+    .tp_clear			= 0,
+    .tp_richcompare		= 0,
+    .tp_weaklistoffset	= 0,
+    .tp_iter			= 0,
+    .tp_iternext		= 0,
+    .tp_methods			= AerospikeRecord_Type_Methods,
+    .tp_members			= 0,
+    .tp_getset			= AerospikeRecord_Type_GetSet,
+    .tp_base			= 0,
+    .tp_dict			= 0,
+    .tp_descr_get		= 0,
+    .tp_descr_set		= 0,
+    .tp_dictoffset		= 0,
+    .tp_init			= 0,
+    .tp_alloc			= 0,
+    .tp_new				= 0
+};
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+PyTypeObject * AerospikeRecord_Ready()
+{
+	return PyType_Ready(&AerospikeRecord_Type) == 0 ? &AerospikeRecord_Type : NULL;
+}
+
+PyObject * AerospikeRecord_New(as_error * err, as_record ** rec, const as_key * key, PyObject * py_key, AerospikeClient * client)
+{
+	as_error_reset(err);
+
+	if ( ! *rec ) {
+		return NULL;
+	}
+
+	AerospikeRecord * self = PyObject_New(AerospikeRecord, &AerospikeRecord_Type);
+	if ( self == NULL ) {
+		as_record_destroy(*rec);
+		*rec = NULL;
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "failed to allocate record");
+		return NULL;
+	}
+
+	self->rec = *rec;
+	self->owner = record_to_capsule(*rec);
+	self->client = client;
+	self->key = NULL;
+	self->meta = NULL;
+	self->bins = _PyDict_NewPresized(self->rec->bins.size);
+	Py_INCREF(client);
+	*rec = NULL;
+
+	result_key_to_pyobject(client, err, key ? key : &self->rec->key, py_key, &self->key);
+	if ( err->code == AEROSPIKE_OK ) {
+		metadata_to_pyobject(err, self->rec, &self->meta);
+	}
+
+	if ( err->code != AEROSPIKE_OK ) {
+		Py_DECREF(self);
+		return NULL;
+	}
+
+	return (PyObject *) self;
+}
+
+PyObject * AerospikeRecord_Retain(as_error * err, const as_record * rec, const as_key * key, AerospikeClient * client)
+{
+	const as_bins * bins = &rec->bins;
+	as_record * copy = as_record_new(bins->size);
+
+	copy->gen = rec->gen;
+	copy->ttl = rec->ttl;
+
+	for ( uint16_t i = 0; i < bins->size; i++ ) {
+		as_bin * bin = &bins->entries[i];
+		as_val * val = (as_val *) bin->valuep;
+
+		switch ( as_val_type(val) ) {
+			case AS_INTEGER: {
+				as_record_set_int64(copy, bin->name, as_integer_get((as_integer *) val));
+				break;
+			}
+			case AS_DOUBLE: {
+				as_record_set_double(copy, bin->name, as_double_get((as_double *) val));
+				break;
+			}
+			case AS_STRING: {
+				// Take over the buffer, if the caller's record owns it
+				as_string * s = (as_string *) val;
+				if ( s->free ) {
+					as_record_set_strp(copy, bin->name, s->value, true);
+					s->free = false;
+				}
+				else {
+					as_record_set_strp(copy, bin->name, strdup(s->value), true);
+				}
+				break;
+			}
+			case AS_BYTES: {
+				// Keep the type, which tells how the bytes are deserialized
+				as_bytes * b = (as_bytes *) val;
+				as_bytes * bytes = NULL;
+				if ( b->free ) {
+					bytes = as_bytes_new_wrap(b->value, b->size, true);
+					b->free = false;
+				}
+				else {
+					uint8_t * value = (uint8_t *) malloc(b->size);
+					memcpy(value, b->value, b->size);
+					bytes = as_bytes_new_wrap(value, b->size, true);
+				}
+				as_bytes_set_type(bytes, as_bytes_get_type(b));
+				as_record_set_bytes(copy, bin->name, bytes);
+				break;
+			}
+			default: {
+				// Containers are reference counted, and other values are
+				// immutable, so share them
+				as_val_reserve(val);
+				as_record_set(copy, bin->name, (as_bin_value *) val);
+				break;
+			}
+		}
+	}
+
+	return AerospikeRecord_New(err, &copy, key ? key : &rec->key, NULL, client);
+}
+
+as_status result_to_pyobject(as_error * err, const as_val * val, AerospikeClient * client, PyObject ** obj)
+{
+	if ( as_val_type(val) != AS_REC ) {
+		return val_to_pyobject_owned(client, err, val, NULL, obj);
+	}
+	else if ( client->lazy_records ) {
+		*obj = AerospikeRecord_Retain(err, as_record_fromval(val), NULL, client);
+		return err->code;
+	}
+	else {
+		return record_to_pyobject(client, err, as_record_fromval(val), NULL, NULL, obj);
+	}
+}
@@ -0,0 +1,1004 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <aerospike/as_bytes.h>
+#include <aerospike/as_double.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_integer.h>
+#include <aerospike/as_list.h>
+#include <aerospike/as_map.h>
+#include <aerospike/as_record.h>
+#include <aerospike/as_string.h>
+#include <aerospike/as_val.h>
+
+#include "compression.h"
+#include "conversions.h"
+#include "intern.h"
+#include "packer.h"
+#include "record.h"
+#include "results.h"
+#include "serializer.h"
+
+/**
+ * A batch is handed to the callback once it holds this many results, or
+ * this many bytes of flattened results.
+ */
+#define RESULTS_BATCH_MAX_RESULTS 128
+#define RESULTS_BATCH_MAX_BYTES (256 * 1024)
+
+/**
+ * The node threads block once a queue holds this many results, or this many
+ * bytes of flattened results. Queued chunks are filled up to the batch size.
+ */
+#define RESULTS_QUEUE_MAX_RESULTS 4096
+#define RESULTS_QUEUE_MAX_BYTES (8 * 1024 * 1024)
+
+/**
+ * The first byte of each flattened result. A value is followed by the value.
+ * A record is followed by the namespace, set, key and digest of its key, in
+ * the order of the key tuple, then its generation, ttl and a map of its bins.
+ */
+enum {
+	FLAT_VALUE = 0,
+	FLAT_RECORD = 1
+};
+
+static int64_t now_ms()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return (int64_t) tv.tv_sec * 1000 + tv.tv_usec / 1000;
+}
+
+/**
+ * Waits on the condition for up to timeout_ms.
+ */
+static void cond_wait_ms(pthread_cond_t * cond, pthread_mutex_t * lock, uint32_t timeout_ms)
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+
+	struct timespec deadline;
+	deadline.tv_sec = tv.tv_sec + timeout_ms / 1000;
+	deadline.tv_nsec = (long) tv.tv_usec * 1000 + (long) (timeout_ms % 1000) * 1000000;
+	if ( deadline.tv_nsec >= 1000000000 ) {
+		deadline.tv_sec++;
+		deadline.tv_nsec -= 1000000000;
+	}
+
+	pthread_cond_timedwait(cond, lock, &deadline);
+}
+
+/*******************************************************************************
+ * FLATTEN (WITHOUT THE GIL)
+ ******************************************************************************/
+
+typedef struct {
+	const AerospikeClient * client;
+	pack_buffer * buffer;
+	int depth;
+	bool ok;
+} flatten_data;
+
+static bool flatten_val(flatten_data * f, const as_val * val);
+
+static bool flatten_list_each(as_val * val, void * udata)
+{
+	return flatten_val((flatten_data *) udata, val);
+}
+
+static bool flatten_map_each(const as_val * key, const as_val * val, void * udata)
+{
+	flatten_data * f = (flatten_data *) udata;
+	return flatten_val(f, key) && flatten_val(f, val);
+}
+
+/**
+ * Flattens the value a compressed bin was compressed from. Returns false when
+ * the bytes are not compressed.
+ */
+static bool flatten_compressed(flatten_data * f, const as_bytes * bval)
+{
+	as_val_t val_type = AS_UNDEF;
+	as_bytes_type bytes_type = AS_BYTES_UNDEF;
+	uint8_t * data = NULL;
+	uint32_t size = 0;
+
+	if ( ! f->client->decompress || ! compression_inflate(bval, &val_type, &bytes_type, &data, &size) ) {
+		return false;
+	}
+
+	if ( val_type == AS_STRING ) {
+		pack_str(f->buffer, (const char *) data, size);
+	}
+	else if ( f->client->deserializer.type != SERIALIZER_NONE && bytes_type == AS_BYTES_PYTHON ) {
+		pack_ext(f->buffer, AS_BYTES_PYTHON, data, size);
+	}
+	else {
+		pack_bin(f->buffer, data, size);
+	}
+
+	free(data);
+	return true;
+}
+
+/**
+ * Flattens a value into the form val_to_pyobject_owned() would convert it
+ * to. Fails for the types without a flat form, which are converted directly.
+ */
+static bool flatten_val(flatten_data * f, const as_val * val)
+{
+	pack_buffer * b = f->buffer;
+
+	if ( val == NULL ) {
+		pack_nil(b);
+		return f->ok;
+	}
+
+	switch ( as_val_type(val) ) {
+		case AS_NIL: {
+			pack_nil(b);
+			break;
+		}
+		case AS_INTEGER: {
+			pack_int(b, as_integer_get(as_integer_fromval(val)));
+			break;
+		}
+		case AS_DOUBLE: {
+			pack_double(b, as_double_get(as_double_fromval(val)));
+			break;
+		}
+		case AS_STRING: {
+			as_string * s = as_string_fromval(val);
+			char * str = as_string_get(s);
+			if ( str != NULL ) {
+				pack_str(b, str, as_string_len(s));
+			}
+			else {
+				pack_nil(b);
+			}
+			break;
+		}
+		case AS_BYTES: {
+			as_bytes * bval = as_bytes_fromval(val);
+			if ( flatten_compressed(f, bval) ) {
+				break;
+			}
+			if ( f->client->deserializer.type != SERIALIZER_NONE && as_bytes_get_type(bval) == AS_BYTES_PYTHON ) {
+				// Deserialized when the batch is materialized
+				pack_ext(b, AS_BYTES_PYTHON, as_bytes_get(bval), as_bytes_size(bval));
+			}
+			else {
+				pack_bin(b, as_bytes_get(bval), as_bytes_size(bval));
+			}
+			break;
+		}
+		case AS_LIST: {
+			as_list * l = as_list_fromval((as_val *) val);
+			if ( f->depth >= PACK_MAX_DEPTH ) {
+				f->ok = false;
+				break;
+			}
+			pack_array_header(b, as_list_size(l));
+			f->depth++;
+			as_list_foreach(l, flatten_list_each, f);
+			f->depth--;
+			break;
+		}
+		case AS_MAP: {
+			as_map * m = as_map_fromval(val);
+			if ( f->depth >= PACK_MAX_DEPTH ) {
+				f->ok = false;
+				break;
+			}
+			pack_map_header(b, as_map_size(m));
+			f->depth++;
+			as_map_foreach(m, flatten_map_each, f);
+			f->depth--;
+			break;
+		}
+		default: {
+			f->ok = false;
+			break;
+		}
+	}
+
+	return f->ok;
+}
+
+static void flatten_cstr(pack_buffer * b, const char * str)
+{
+	size_t len = strlen(str);
+	if ( len > 0 ) {
+		pack_str(b, str, len);
+	}
+	else {
+		pack_nil(b);
+	}
+}
+
+/**
+ * Flattens the key of a record, as key_to_pyobject() would convert it.
+ */
+static void flatten_key(pack_buffer * b, const as_key * key)
+{
+	flatten_cstr(b, key->ns);
+	flatten_cstr(b, key->set);
+
+	const as_val * val = (const as_val *) key->valuep;
+	switch ( val ? as_val_type(val) : AS_UNDEF ) {
+		case AS_INTEGER: {
+			pack_int(b, as_integer_get(as_integer_fromval(val)));
+			break;
+		}
+		case AS_STRING: {
+			as_string * s = as_string_fromval(val);
+			pack_str(b, as_string_get(s), as_string_len(s));
+			break;
+		}
+		case AS_BYTES: {
+			as_bytes * bval = as_bytes_fromval(val);
+			pack_bin(b, as_bytes_get(bval), as_bytes_size(bval));
+			break;
+		}
+		default: {
+			pack_nil(b);
+			break;
+		}
+	}
+
+	// The digest is a str, like the one of key_to_pyobject()
+	if ( key->digest.init ) {
+		pack_str(b, (const char *) key->digest.value, AS_DIGEST_VALUE_SIZE);
+	}
+	else {
+		pack_nil(b);
+	}
+}
+
+static bool flatten_result(const AerospikeClient * client, pack_buffer * b, const as_val * val)
+{
+	flatten_data f = { client, b, 0, true };
+
+	if ( as_val_type(val) != AS_REC ) {
+		*pack_reserve(b, 1) = FLAT_VALUE;
+		return flatten_val(&f, val);
+	}
+
+	const as_record * rec = as_record_fromval(val);
+
+	*pack_reserve(b, 1) = FLAT_RECORD;
+	flatten_key(b, &rec->key);
+	pack_int(b, rec->gen);
+	pack_int(b, rec->ttl);
+
+	uint32_t n_bins = 0;
+	for ( uint16_t i = 0; i < rec->bins.size; i++ ) {
+		if ( rec->bins.entries[i].valuep != NULL ) {
+			n_bins++;
+		}
+	}
+
+	pack_map_header(b, n_bins);
+	for ( uint16_t i = 0; i < rec->bins.size && f.ok; i++ ) {
+		const as_bin * bin = &rec->bins.entries[i];
+		if ( bin->valuep != NULL ) {
+			pack_str(b, bin->name, strlen(bin->name));
+			flatten_val(&f, (const as_val *) bin->valuep);
+		}
+	}
+
+	return f.ok;
+}
+
+/*******************************************************************************
+ * MATERIALIZE (WITH THE GIL)
+ ******************************************************************************/
+
+static as_status unpack_ext(unpack_reader * r, as_error * err, int8_t type, const uint8_t * data, uint32_t size, PyObject ** py_obj)
+{
+	AerospikeClient * client = (AerospikeClient *) r->udata;
+
+	if ( type != AS_BYTES_PYTHON ) {
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "result has an unsupported msgpack ext type %d", type);
+	}
+
+	return serializer_load(&client->deserializer, err, data, size, py_obj);
+}
+
+static as_status unpack_record(AerospikeClient * client, unpack_reader * r, as_error * err, PyObject ** py_rec)
+{
+	PyObject * py_key = PyTuple_New(4);
+	PyObject * py_meta = NULL;
+	PyObject * py_bins = NULL;
+
+	for ( Py_ssize_t i = 0; i < 4; i++ ) {
+		PyObject * py_item = NULL;
+		if ( unpack_pyobject(r, err, &py_item, 0) != AEROSPIKE_OK ) {
+			goto CLEANUP;
+		}
+		PyTuple_SET_ITEM(py_key, i, py_item);
+	}
+
+	uint64_t gen = 0;
+	uint64_t ttl = 0;
+	if ( unpack_uint(r, err, &gen) != AEROSPIKE_OK || unpack_uint(r, err, &ttl) != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+
+	py_meta = PyDict_New();
+	PyObject * py_ttl = PyInt_FromLong((long) ttl);
+	PyObject * py_gen = PyInt_FromLong((long) gen);
+	PyDict_SetItemString(py_meta, "ttl", py_ttl);
+	PyDict_SetItemString(py_meta, "gen", py_gen);
+	Py_DECREF(py_ttl);
+	Py_DECREF(py_gen);
+
+	size_t n_bins = 0;
+	if ( unpack_map_header(r, err, &n_bins) != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+
+	py_bins = _PyDict_NewPresized((Py_ssize_t) n_bins);
+	for ( size_t i = 0; i < n_bins; i++ ) {
+		const char * name = NULL;
+		size_t name_len = 0;
+		as_bin_name bin_name;
+		PyObject * py_val = NULL;
+
+		if ( unpack_str(r, err, &name, &name_len) != AEROSPIKE_OK ) {
+			goto CLEANUP;
+		}
+		if ( name_len >= sizeof(as_bin_name) ) {
+			as_error_update(err, AEROSPIKE_ERR_CLIENT, "result has a bin name longer than %d characters", (int) sizeof(as_bin_name) - 1);
+			goto CLEANUP;
+		}
+		if ( unpack_pyobject(r, err, &py_val, 0) != AEROSPIKE_OK ) {
+			goto CLEANUP;
+		}
+
+		memcpy(bin_name, name, name_len);
+		bin_name[name_len] = '\0';
+
+		PyObject * py_name = intern_table_get(client->bin_names, bin_name);
+		PyDict_SetItem(py_bins, py_name, py_val);
+		Py_DECREF(py_name);
+		Py_DECREF(py_val);
+	}
+
+	*py_rec = PyTuple_Pack(3, py_key, py_meta, py_bins);
+
+CLEANUP:
+
+	Py_XDECREF(py_key);
+	Py_XDECREF(py_meta);
+	Py_XDECREF(py_bins);
+
+	return err->code;
+}
+
+/**
+ * Converts the next flattened result of a reader.
+ */
+static as_status unflatten_result(AerospikeClient * client, unpack_reader * r, as_error * err, PyObject ** py_result)
+{
+	if ( *r->pos++ == FLAT_RECORD ) {
+		return unpack_record(client, r, err, py_result);
+	}
+	return unpack_pyobject(r, err, py_result, 0);
+}
+
+/**
+ * Stops the batch, keeping the first error and Python exception which
+ * stopped it. Requires the GIL.
+ */
+static void results_batch_stop(results_batch * batch, const as_error * err)
+{
+	pthread_mutex_lock(&batch->lock);
+	batch->stopped = true;
+	pthread_mutex_unlock(&batch->lock);
+
+	if ( err && batch->error.code == AEROSPIKE_OK ) {
+		as_error_copy(&batch->error, err);
+	}
+
+	if ( PyErr_Occurred() ) {
+		if ( batch->py_exc_type == NULL ) {
+			PyErr_Fetch(&batch->py_exc_type, &batch->py_exc_value, &batch->py_exc_traceback);
+		}
+		else {
+			PyErr_Clear();
+		}
+	}
+}
+
+/**
+ * Hands the collected list of results to the callback. Requires the GIL.
+ */
+static void results_batch_flush(results_batch * batch)
+{
+	if ( batch->py_batch == NULL || PyList_GET_SIZE(batch->py_batch) == 0 || batch->stopped ) {
+		return;
+	}
+
+	PyObject * py_list = batch->py_batch;
+	batch->py_batch = PyList_New(0);
+
+	if ( batch->callback(py_list, batch->udata) == false ) {
+		results_batch_stop(batch, NULL);
+	}
+
+	Py_DECREF(py_list);
+}
+
+static void results_batch_call(results_batch * batch, as_error * err, PyObject * py_result)
+{
+	if ( err->code == AEROSPIKE_OK && py_result == NULL ) {
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "result could not be converted");
+	}
+
+	if ( err->code != AEROSPIKE_OK ) {
+		Py_XDECREF(py_result);
+		results_batch_stop(batch, err);
+		return;
+	}
+
+	if ( batch->batch_size == 0 ) {
+		if ( batch->callback(py_result, batch->udata) == false ) {
+			results_batch_stop(batch, NULL);
+		}
+		Py_DECREF(py_result);
+		return;
+	}
+
+	if ( PyList_GET_SIZE(batch->py_batch) == 0 ) {
+		batch->batch_since = now_ms();
+	}
+
+	PyList_Append(batch->py_batch, py_result);
+	Py_DECREF(py_result);
+
+	if ( PyList_GET_SIZE(batch->py_batch) >= batch->batch_size ) {
+		results_batch_flush(batch);
+	}
+}
+
+/**
+ * Materializes the flattened results of a buffer, and hands them to the
+ * callback. Requires the GIL.
+ */
+static void results_batch_drain(results_batch * batch, const pack_buffer * b)
+{
+	unpack_reader r = { b->data, b->data + b->size, unpack_ext, batch->client };
+
+	while ( r.pos < r.end && ! batch->stopped ) {
+		as_error err;
+		as_error_init(&err);
+
+		PyObject * py_result = NULL;
+		unflatten_result(batch->client, &r, &err, &py_result);
+
+		results_batch_call(batch, &err, py_result);
+	}
+}
+
+/**
+ * Hands over the pending results and the partial list, once the oldest of
+ * them has waited the maximum delay, for when no result arrives to do it.
+ * Requires the GIL.
+ */
+static void results_batch_flush_late(results_batch * batch)
+{
+	if ( batch->max_delay_ms <= 0 || batch->stopped ) {
+		return;
+	}
+
+	int64_t now = now_ms();
+	pack_buffer late = { NULL, 0, 0 };
+
+	pthread_mutex_lock(&batch->lock);
+	if ( batch->n_pending > 0 && now - batch->pending_since >= batch->max_delay_ms ) {
+		late = batch->pending;
+		batch->pending = (pack_buffer) { NULL, 0, 0 };
+		batch->n_pending = 0;
+	}
+	pthread_mutex_unlock(&batch->lock);
+
+	results_batch_drain(batch, &late);
+	free(late.data);
+
+	if ( late.size > 0 || now - batch->batch_since >= batch->max_delay_ms ) {
+		results_batch_flush(batch);
+	}
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+void results_batch_init(results_batch * batch, AerospikeClient * client, uint32_t batch_size, uint32_t max_delay_ms, results_batch_callback callback, void * udata)
+{
+	batch->client = client;
+	batch->callback = callback;
+	batch->udata = udata;
+	batch->batch_size = batch_size;
+	batch->max_delay_ms = max_delay_ms;
+
+	pthread_mutex_init(&batch->lock, NULL);
+	batch->pending = (pack_buffer) { NULL, 0, 0 };
+	batch->n_pending = 0;
+	batch->max_pending = batch_size > RESULTS_BATCH_MAX_RESULTS ? batch_size : RESULTS_BATCH_MAX_RESULTS;
+	batch->pending_since = 0;
+
+	batch->py_batch = batch_size > 0 ? PyList_New(0) : NULL;
+	batch->batch_since = 0;
+
+	batch->limit = 0;
+	batch->cancel = NULL;
+	batch->n_added = 0;
+
+	batch->stopped = false;
+	as_error_init(&batch->error);
+	batch->py_exc_type = NULL;
+	batch->py_exc_value = NULL;
+	batch->py_exc_traceback = NULL;
+}
+
+bool results_batch_add(results_batch * batch, const as_val * val)
+{
+	AerospikeClient * client = batch->client;
+
+	// Records are flattened in parallel, outside of the lock. Lazy records
+	// keep the record itself, so they are converted directly.
+	pack_buffer b = { NULL, 0, 0 };
+	bool flat = ! client->lazy_records && flatten_result(client, &b, val);
+
+	pack_buffer full = { NULL, 0, 0 };
+
+	int64_t now = batch->max_delay_ms > 0 ? now_ms() : 0;
+
+	pthread_mutex_lock(&batch->lock);
+
+	if ( AerospikeCancelToken_Cancelled(batch->cancel) ) {
+		batch->stopped = true;
+	}
+
+	if ( batch->stopped || ( batch->limit > 0 && batch->n_added >= batch->limit ) ) {
+		pthread_mutex_unlock(&batch->lock);
+		free(b.data);
+		return false;
+	}
+
+	batch->n_added++;
+	bool last = batch->limit > 0 && batch->n_added >= batch->limit;
+
+	if ( flat ) {
+		if ( batch->n_pending == 0 ) {
+			batch->pending_since = now;
+		}
+		if ( batch->pending.data == NULL ) {
+			batch->pending = b;
+			b = (pack_buffer) { NULL, 0, 0 };
+		}
+		else {
+			memcpy(pack_reserve(&batch->pending, b.size), b.data, b.size);
+		}
+		batch->n_pending++;
+	}
+
+	bool late = batch->max_delay_ms > 0 && now - batch->pending_since >= batch->max_delay_ms;
+
+	// A result which is converted directly follows the pending results, and
+	// the last result is handed over right away
+	if ( ! flat || late || last || batch->n_pending >= batch->max_pending || batch->pending.size >= RESULTS_BATCH_MAX_BYTES ) {
+		full = batch->pending;
+		batch->pending = (pack_buffer) { NULL, 0, 0 };
+		batch->n_pending = 0;
+	}
+
+	pthread_mutex_unlock(&batch->lock);
+
+	free(b.data);
+
+	if ( full.size == 0 && flat ) {
+		free(full.data);
+		return ! last;
+	}
+
+	PyGILState_STATE gstate = PyGILState_Ensure();
+
+	results_batch_drain(batch, &full);
+
+	if ( ! flat && ! batch->stopped ) {
+		as_error err;
+		as_error_init(&err);
+
+		PyObject * py_result = NULL;
+		result_to_pyobject(&err, val, client, &py_result);
+		results_batch_call(batch, &err, py_result);
+	}
+
+	if ( last || ( batch->max_delay_ms > 0 && now - batch->batch_since >= batch->max_delay_ms ) ) {
+		results_batch_flush(batch);
+	}
+
+	bool more = ! batch->stopped && ! last;
+
+	PyGILState_Release(gstate);
+
+	free(full.data);
+
+	return more;
+}
+
+bool results_batch_finish(results_batch * batch, as_error * err)
+{
+	results_batch_drain(batch, &batch->pending);
+	results_batch_flush(batch);
+	Py_CLEAR(batch->py_batch);
+
+	free(batch->pending.data);
+	batch->pending = (pack_buffer) { NULL, 0, 0 };
+	batch->n_pending = 0;
+
+	pthread_mutex_destroy(&batch->lock);
+
+	if ( batch->py_exc_type != NULL ) {
+		PyErr_Restore(batch->py_exc_type, batch->py_exc_value, batch->py_exc_traceback);
+		batch->py_exc_type = NULL;
+		batch->py_exc_value = NULL;
+		batch->py_exc_traceback = NULL;
+		return false;
+	}
+
+	// A scan or query which the batch stopped ends with an abort error, 
+	// which is replaced by the error which stopped the batch, if any
+	if ( batch->stopped || ( batch->limit > 0 && batch->n_added >= batch->limit ) ) {
+		as_error_reset(err);
+	}
+
+	if ( batch->error.code != AEROSPIKE_OK ) {
+		as_error_copy(err, &batch->error);
+	}
+
+	return true;
+}
+
+typedef struct {
+	results_run_fn run;
+	void * udata;
+	as_error err;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	bool done;
+} results_runner;
+
+static void * results_runner_main(void * udata)
+{
+	results_runner * runner = (results_runner *) udata;
+
+	runner->run(&runner->err, runner->udata);
+
+	pthread_mutex_lock(&runner->lock);
+	runner->done = true;
+	pthread_cond_broadcast(&runner->cond);
+	pthread_mutex_unlock(&runner->lock);
+
+	return NULL;
+}
+
+void results_batch_run(results_batch * batch, results_run_fn run, void * udata, as_error * err)
+{
+	results_runner runner;
+	runner.run = run;
+	runner.udata = udata;
+	as_error_init(&runner.err);
+	pthread_mutex_init(&runner.lock, NULL);
+	pthread_cond_init(&runner.cond, NULL);
+	runner.done = false;
+
+	pthread_t thread;
+
+	if ( pthread_create(&thread, NULL, results_runner_main, &runner) != 0 ) {
+		// Run on the calling thread, which can not check for signals then
+		PyThreadState * _save = PyEval_SaveThread();
+		run(&runner.err, udata);
+		PyEval_RestoreThread(_save);
+	}
+	else {
+		bool done = false;
+
+		// Wake up often enough to hand over the results of a quiet scan
+		uint32_t wait_ms = RESULTS_WAIT_MS;
+		if ( batch->max_delay_ms > 0 && batch->max_delay_ms < wait_ms ) {
+			wait_ms = (uint32_t) batch->max_delay_ms;
+		}
+
+		while ( ! done ) {
+			PyThreadState * _save = PyEval_SaveThread();
+			pthread_mutex_lock(&runner.lock);
+			if ( ! runner.done ) {
+				cond_wait_ms(&runner.cond, &runner.lock, wait_ms);
+			}
+			done = runner.done;
+			pthread_mutex_unlock(&runner.lock);
+			PyEval_RestoreThread(_save);
+
+			// The exception of a signal handler stops the batch, which keeps
+			// the exception until the batch finishes
+			if ( ! done && ( PyErr_CheckSignals() != 0 || AerospikeCancelToken_Cancelled(batch->cancel) ) ) {
+				results_batch_stop(batch, NULL);
+			}
+			else if ( ! done ) {
+				results_batch_flush_late(batch);
+			}
+		}
+
+		pthread_join(thread, NULL);
+	}
+
+	pthread_cond_destroy(&runner.cond);
+	pthread_mutex_destroy(&runner.lock);
+
+	as_error_copy(err, &runner.err);
+}
+
+void results_queue_init(results_queue * queue, AerospikeClient * client)
+{
+	queue->client = client;
+
+	pthread_mutex_init(&queue->lock, NULL);
+	pthread_cond_init(&queue->not_full, NULL);
+	pthread_cond_init(&queue->not_empty, NULL);
+	queue->head = NULL;
+	queue->tail = NULL;
+	queue->n_queued = 0;
+	queue->bytes_queued = 0;
+
+	queue->limit = 0;
+	queue->cancel = NULL;
+	queue->n_added = 0;
+
+	queue->stopped = false;
+	queue->done = false;
+	as_error_init(&queue->error);
+}
+
+/**
+ * Stops the queue with the error which stopped it.
+ */
+static void results_queue_fail(results_queue * queue, const as_error * err)
+{
+	pthread_mutex_lock(&queue->lock);
+	if ( queue->error.code == AEROSPIKE_OK ) {
+		as_error_copy(&queue->error, err);
+	}
+	queue->stopped = true;
+	pthread_cond_broadcast(&queue->not_full);
+	pthread_mutex_unlock(&queue->lock);
+}
+
+bool results_queue_add(results_queue * queue, const as_val * val)
+{
+	AerospikeClient * client = queue->client;
+
+	// Records are flattened in parallel, outside of the lock. Lazy records
+	// keep the record itself, so they are converted directly.
+	pack_buffer b = { NULL, 0, 0 };
+	bool flat = ! client->lazy_records && flatten_result(client, &b, val);
+
+	PyObject * py_result = NULL;
+
+	if ( ! flat ) {
+		free(b.data);
+		b = (pack_buffer) { NULL, 0, 0 };
+
+		as_error err;
+		as_error_init(&err);
+
+		PyGILState_STATE gstate = PyGILState_Ensure();
+		result_to_pyobject(&err, val, client, &py_result);
+		if ( err.code == AEROSPIKE_OK && py_result == NULL ) {
+			as_error_update(&err, AEROSPIKE_ERR_CLIENT, "result could not be converted");
+		}
+		if ( err.code != AEROSPIKE_OK ) {
+			PyErr_Clear();
+			Py_CLEAR(py_result);
+		}
+		PyGILState_Release(gstate);
+
+		if ( err.code != AEROSPIKE_OK ) {
+			results_queue_fail(queue, &err);
+			return false;
+		}
+	}
+
+	size_t size = b.size;
+
+	pthread_mutex_lock(&queue->lock);
+
+	while ( ! queue->stopped && queue->n_queued > 0 &&
+			( queue->n_queued >= RESULTS_QUEUE_MAX_RESULTS || queue->bytes_queued >= RESULTS_QUEUE_MAX_BYTES ) ) {
+		// Wakes up regularly, as a cancelled token does not signal the queue
+		cond_wait_ms(&queue->not_full, &queue->lock, RESULTS_WAIT_MS);
+		if ( AerospikeCancelToken_Cancelled(queue->cancel) ) {
+			queue->stopped = true;
+		}
+	}
+
+	if ( AerospikeCancelToken_Cancelled(queue->cancel) ) {
+		queue->stopped = true;
+	}
+
+	if ( queue->stopped || ( queue->limit > 0 && queue->n_added >= queue->limit ) ) {
+		pthread_mutex_unlock(&queue->lock);
+		free(b.data);
+		if ( py_result != NULL ) {
+			PyGILState_STATE gstate = PyGILState_Ensure();
+			Py_DECREF(py_result);
+			PyGILState_Release(gstate);
+		}
+		return false;
+	}
+
+	results_chunk * tail = queue->tail;
+
+	if ( flat && tail != NULL && tail->py_result == NULL &&
+			tail->n_results < RESULTS_BATCH_MAX_RESULTS && tail->flat.size < RESULTS_BATCH_MAX_BYTES ) {
+		memcpy(pack_reserve(&tail->flat, b.size), b.data, b.size);
+		tail->n_results++;
+	}
+	else {
+		results_chunk * chunk = (results_chunk *) malloc(sizeof(results_chunk));
+		chunk->next = NULL;
+		chunk->flat = b;
+		chunk->pos = 0;
+		chunk->n_results = 1;
+		chunk->py_result = py_result;
+		b = (pack_buffer) { NULL, 0, 0 };
+
+		if ( tail != NULL ) {
+			tail->next = chunk;
+		}
+		else {
+			queue->head = chunk;
+		}
+		queue->tail = chunk;
+	}
+
+	queue->n_queued++;
+	queue->bytes_queued += size;
+	queue->n_added++;
+
+	bool more = queue->limit == 0 || queue->n_added < queue->limit;
+
+	pthread_cond_signal(&queue->not_empty);
+	pthread_mutex_unlock(&queue->lock);
+
+	free(b.data);
+
+	return more;
+}
+
+void results_queue_done(results_queue * queue, const as_error * err)
+{
+	pthread_mutex_lock(&queue->lock);
+
+	// A scan or query which the queue stopped ends with an abort error
+	bool stopped = queue->stopped || ( queue->limit > 0 && queue->n_added >= queue->limit );
+
+	if ( ! stopped && err != NULL && err->code != AEROSPIKE_OK && queue->error.code == AEROSPIKE_OK ) {
+		as_error_copy(&queue->error, err);
+	}
+	queue->done = true;
+	pthread_cond_broadcast(&queue->not_empty);
+	pthread_mutex_unlock(&queue->lock);
+}
+
+void results_queue_stop(results_queue * queue)
+{
+	pthread_mutex_lock(&queue->lock);
+	queue->stopped = true;
+	pthread_cond_broadcast(&queue->not_full);
+	pthread_mutex_unlock(&queue->lock);
+}
+
+results_chunk * results_queue_take(results_queue * queue, uint32_t timeout_ms, bool * done, as_error * err)
+{
+	pthread_mutex_lock(&queue->lock);
+
+	if ( queue->head == NULL && ! queue->done ) {
+		cond_wait_ms(&queue->not_empty, &queue->lock, timeout_ms);
+	}
+
+	*done = queue->head == NULL && queue->done;
+
+	results_chunk * chunk = queue->head;
+
+	if ( chunk != NULL ) {
+		queue->head = chunk->next;
+		if ( queue->head == NULL ) {
+			queue->tail = NULL;
+		}
+		chunk->next = NULL;
+
+		queue->n_queued -= chunk->n_results;
+		queue->bytes_queued -= chunk->flat.size;
+		pthread_cond_broadcast(&queue->not_full);
+	}
+	else if ( *done && queue->error.code != AEROSPIKE_OK ) {
+		as_error_copy(err, &queue->error);
+	}
+
+	pthread_mutex_unlock(&queue->lock);
+
+	return chunk;
+}
+
+void results_queue_destroy(results_queue * queue)
+{
+	while ( queue->head != NULL ) {
+		results_chunk * chunk = queue->head;
+		queue->head = chunk->next;
+		results_chunk_destroy(chunk);
+	}
+	queue->tail = NULL;
+
+	pthread_cond_destroy(&queue->not_empty);
+	pthread_cond_destroy(&queue->not_full);
+	pthread_mutex_destroy(&queue->lock);
+}
+
+as_status results_chunk_next(results_chunk * chunk, AerospikeClient * client, as_error * err, PyObject ** py_result)
+{
+	as_error_reset(err);
+	*py_result = NULL;
+
+	if ( chunk->py_result != NULL ) {
+		*py_result = chunk->py_result;
+		chunk->py_result = NULL;
+		return err->code;
+	}
+
+	if ( chunk->pos >= chunk->flat.size ) {
+		return err->code;
+	}
+
+	unpack_reader r = { chunk->flat.data + chunk->pos, chunk->flat.data + chunk->flat.size, unpack_ext, client };
+	unflatten_result(client, &r, err, py_result);
+
+	// A result which fails to convert ends the chunk
+	chunk->pos = err->code == AEROSPIKE_OK ? (size_t) (r.pos - chunk->flat.data) : chunk->flat.size;
+
+	return err->code;
+}
+
+void results_chunk_destroy(results_chunk * chunk)
+{
+	if ( chunk != NULL ) {
+		Py_XDECREF(chunk->py_result);
+		free(chunk->flat.data);
+		free(chunk);
+	}
+}
@@ -21,17 +21,13 @@
 #include <aerospike/as_error.h>
 #include <aerospike/as_scan.h>
 
+#include "cancel.h"
 #include "client.h"
 #include "conversions.h"
 #include "scan.h"
 #include "policy.h"
-
-// Struct for Python User-Data for the Callback
-typedef struct {
-	as_error error;
-	PyObject * callback;
-} LocalData;
-
+#include "record.h"
+#include "results.h"
 
 static bool each_result(const as_val * val, void * udata)
 {
@@ -39,37 +35,36 @@ static bool each_result(const as_val * val, void * udata)
 		return false;
 	}
 
-	// Extract callback user-data
-	LocalData * data = (LocalData *) udata;
-	as_error * err = &data->error;
-	PyObject * py_callback = data->callback;
-
-	// Python Function Arguments and Result Value
-	PyObject * py_arglist = NULL; 
-	PyObject * py_result = NULL;
-
-	// Lock Python State
-	PyGILState_STATE gstate;
-	gstate = PyGILState_Ensure();
-
-	// Convert as_val to a Python Object
-	val_to_pyobject(err, val, &py_result);
+	return results_batch_add((results_batch *) udata, val);
+}
 
-	// Build Python Function Arguments
-	py_arglist = Py_BuildValue("(O)", py_result);
+static bool each_batch_result(PyObject * py_result, void * udata)
+{
+	PyObject * py_callback = (PyObject *) udata;
 
 	// Invoke Python Callback
-	PyEval_CallObject(py_callback, py_arglist);
+	PyObject * py_ret = PyObject_CallFunctionObjArgs(py_callback, py_result, NULL);
+	if ( py_ret == NULL ) {
+		return false;
+	}
 
-	// TODO: handle return value
+	// Returning False stops the scan
+	bool more = py_ret != Py_False;
+	Py_DECREF(py_ret);
 
-	// Release Python Function Arguments
-	Py_DECREF(py_arglist);
+	return more;
+}
 
-	// Release Python State
-	PyGILState_Release(gstate);
+typedef struct {
+	AerospikeScan * self;
+	as_policy_scan * policy;
+	results_batch * batch;
+} foreach_data;
 
-	return true;
+static void run_scan(as_error * err, void * udata)
+{
+	foreach_data * data = (foreach_data *) udata;
+	aerospike_scan_foreach(data->self->client->as, err, data->policy, &data->self->scan, each_result, data->batch);
 }
 
 PyObject * AerospikeScan_Foreach(AerospikeScan * self, PyObject * args, PyObject * kwds)
@@ -77,12 +72,17 @@ PyObject * AerospikeScan_Foreach(AerospikeScan * self, PyObject * args, PyObject
 	// Python Function Arguments
 	PyObject * py_callback = NULL;
 	PyObject * py_policy = NULL;
+	int batch_size = 0;
+	int max_delay_ms = 0;
+	int limit = 0;
+	PyObject * py_cancel = NULL;
 
 	// Python Function Keyword Arguments
-	static char * kwlist[] = {"callback", "policy", NULL};
+	static char * kwlist[] = {"callback", "policy", "batch_size", "max_delay_ms", "limit", "cancel", NULL};
 
 	// Python Function Argument Parsing
-	if ( PyArg_ParseTupleAndKeywords(args, kwds, "O|O:foreach", kwlist, &py_callback, &py_policy) == false ) {
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "O|OiiiO:foreach", kwlist, 
+			&py_callback, &py_policy, &batch_size, &max_delay_ms, &limit, &py_cancel) == false ) {
 		return NULL;
 	}
 
@@ -90,30 +90,54 @@ PyObject * AerospikeScan_Foreach(AerospikeScan * self, PyObject * args, PyObject
 	as_error err;
 	as_policy_scan policy;
 	as_policy_scan * policy_p = NULL;
+	AerospikeCancelToken * cancel = NULL;
 
 	// Initialize error
 	as_error_init(&err);
 
+	if ( batch_size < 0 ) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "batch_size must not be negative");
+		goto CLEANUP;
+	}
+
+	if ( max_delay_ms < 0 ) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "max_delay_ms must not be negative");
+		goto CLEANUP;
+	}
+
+	if ( limit < 0 ) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "limit must not be negative");
+		goto CLEANUP;
+	}
+
+	pyobject_to_cancel_token(&err, py_cancel, &cancel);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+
 	// Convert python policy object to as_policy_exists
 	pyobject_to_policy_scan(&err, py_policy, &policy, &policy_p);
 	if ( err.code != AEROSPIKE_OK ) {
 		goto CLEANUP;
 	}
 
-	// Create and initialize callback user-data
-	LocalData data;
-	data.callback = py_callback;
-	as_error_init(&data.error);
-	
-	// We are spawning multiple threads
-	PyThreadState * _save = PyEval_SaveThread();
+	// Results are handed to the callback in batches, as lists of batch_size
+	// results when given
+	results_batch batch;
+	results_batch_init(&batch, self->client, (uint32_t) batch_size, (uint32_t) max_delay_ms, each_batch_result, py_callback);
+	batch.limit = (uint32_t) limit;
+	batch.cancel = cancel;
 
-	// Invoke operation
-	aerospike_scan_foreach(self->client->as, &err, policy_p, &self->scan, each_result, &data);
+	// Invoke operation on a native thread, while this thread waits for it,
+	// checking for signals and cancellation
+	foreach_data data = { self, policy_p, &batch };
+	results_batch_run(&batch, run_scan, &data, &err);
+
+	// Raise the exception of the callback or of a signal handler, if any
+	if ( results_batch_finish(&batch, &err) == false ) {
+		return NULL;
+	}
 
-	// We are done using multiple threads
-	PyEval_RestoreThread(_save);
-	
 CLEANUP:
 
 	if ( err.code != AEROSPIKE_OK ) {
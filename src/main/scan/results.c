@@ -15,66 +15,50 @@
  ******************************************************************************/
 
 #include <Python.h>
-#include <pthread.h>
 #include <stdbool.h>
 
-#include <aerospike/aerospike_scan.h>
 #include <aerospike/as_error.h>
-#include <aerospike/as_scan.h>
+#include <aerospike/as_policy.h>
 
+#include "cancel.h"
 #include "client.h"
 #include "conversions.h"
 #include "scan.h"
-
-#undef TRACE
-#define TRACE()
-
-static bool each_result(const as_val * val, void * udata)
-{
-	if ( !val ) {
-		return false;
-	}
-
-	PyObject * py_results = (PyObject *) udata;
-	PyObject * py_result = NULL;
-
-	as_error err;
-
-	PyGILState_STATE gstate;
-	gstate = PyGILState_Ensure();
-
-	val_to_pyobject(&err, val, &py_result);
-
-	if ( py_result ) {
-		PyList_Append(py_results, py_result);
-		Py_DECREF(py_result);
-	}
-	
-	PyGILState_Release(gstate);
-
-	return true;
-}
+#include "policy.h"
+#include "stream.h"
 
 PyObject * AerospikeScan_Results(AerospikeScan * self, PyObject * args, PyObject * kwds)
 {
+	// Python Function Arguments
 	PyObject * py_policy = NULL;
-	
-	static char * kwlist[] = {"policy", NULL};
-	
-	if ( PyArg_ParseTupleAndKeywords(args, kwds, "|O:foreach", kwlist, &py_policy) == false ) {
+	int limit = 0;
+	PyObject * py_cancel = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"policy", "limit", "cancel", NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "|OiO:results", kwlist, 
+			&py_policy, &limit, &py_cancel) == false ) {
 		return NULL;
 	}
 
+	// Aerospike Client Arguments
 	as_error err;
-	as_error_init(&err);
-
-	PyObject * py_results = PyList_New(0);
+	as_policy_scan policy;
+	as_policy_scan * policy_p = NULL;
+	AerospikeCancelToken * cancel = NULL;
 
-	PyThreadState * _save = PyEval_SaveThread();
+	// Initialize error
+	as_error_init(&err);
 
-	aerospike_scan_foreach(self->client->as, &err, NULL, &self->scan, each_result, py_results);
-	
-	PyEval_RestoreThread(_save);
+	if ( limit < 0 ) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "limit must not be negative");
+	}
+	else if ( pyobject_to_cancel_token(&err, py_cancel, &cancel) == AEROSPIKE_OK ) {
+		// Convert python policy object to as_policy_scan
+		pyobject_to_policy_scan(&err, py_policy, &policy, &policy_p);
+	}
 
 	if ( err.code != AEROSPIKE_OK ) {
 		PyObject * py_err = NULL;
@@ -83,8 +67,6 @@ PyObject * AerospikeScan_Results(AerospikeScan * self, PyObject * args, PyObject
 		return NULL;
 	}
 
-	return py_results;
+	// Start the scan, which streams its results to the iterator
+	return (PyObject *) AerospikeStream_Scan(self, policy_p, (uint32_t) limit, cancel);
 }
-
-
-
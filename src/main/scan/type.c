@@ -25,7 +25,10 @@
 #include <aerospike/as_scan.h>
 
 #include "client.h"
+#include "conversions.h"
+#include "policy.h"
 #include "scan.h"
+#include "stream.h"
 
 /*******************************************************************************
  * PYTHON TYPE METHODS
@@ -40,7 +43,7 @@ static PyMethodDef AerospikeScan_Type_Methods[] = {
     			"Add bins to select in the query."},
 
     {"results",	(PyCFunction) AerospikeScan_Results,	METH_VARARGS | METH_KEYWORDS,
-    			"Get a record."},
+    			"Return an iterator over the results of the scan."},
 	
 	{NULL}
 };
@@ -66,12 +69,13 @@ static int AerospikeScan_Type_Init(AerospikeScan * self, PyObject * args, PyObje
 {
 	PyObject * py_namespace = NULL;
 	PyObject * py_set = NULL;
+	PyObject * py_options = NULL;
 	
-	static char * kwlist[] = {"namespace", "set", NULL};
+	static char * kwlist[] = {"namespace", "set", "options", NULL};
 
-	if ( PyArg_ParseTupleAndKeywords(args, kwds, "O|O:key", kwlist, 
-		&py_namespace, &py_set) == false ) {
-		return 0;
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "O|OO:scan", kwlist, 
+		&py_namespace, &py_set, &py_options) == false ) {
+		return -1;
 	}
 		
 	char * namespace = NULL;
@@ -87,9 +91,28 @@ static int AerospikeScan_Type_Init(AerospikeScan * self, PyObject * args, PyObje
 	
 	as_scan_init(&self->scan, namespace, set);
 
+	as_error err;
+	as_error_init(&err);
+
+	pyobject_to_scan_options(&err, py_options, &self->scan);
+	if ( err.code != AEROSPIKE_OK ) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyErr_SetObject(PyExc_Exception, py_err);
+		return -1;
+	}
+
     return 0;
 }
 
+/**
+ * Iterating a scan runs it, as results() does.
+ */
+static PyObject * AerospikeScan_Type_Iter(AerospikeScan * self)
+{
+	return (PyObject *) AerospikeStream_Scan(self, NULL, 0, NULL);
+}
+
 static void AerospikeScan_Type_Dealloc(PyObject * self)
 {
     self->ob_type->tp_free((PyObject *) self);
@@ -130,7 +153,7 @@ static PyTypeObject AerospikeScan_Type = {
     .tp_clear			= 0,
     .tp_richcompare		= 0,
     .tp_weaklistoffset	= 0,
-    .tp_iter			= 0,
+    .tp_iter			= (getiterfunc) AerospikeScan_Type_Iter,
     .tp_iternext		= 0,
     .tp_methods			= AerospikeScan_Type_Methods,
     .tp_members			= 0,
@@ -159,6 +182,9 @@ AerospikeScan * AerospikeScan_New(AerospikeClient * client, PyObject * args, PyO
     AerospikeScan * self  = (AerospikeScan *) AerospikeScan_Type.tp_new(&AerospikeScan_Type, args, kwds);
     self->client = client;
 	Py_INCREF(client);
-    AerospikeScan_Type.tp_init((PyObject *) self, args, kwds);
+    if ( AerospikeScan_Type.tp_init((PyObject *) self, args, kwds) != 0 ) {
+    	Py_DECREF(self);
+    	return NULL;
+    }
 	return self;
 }
\ No newline at end of file
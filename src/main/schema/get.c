@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include <aerospike/aerospike_key.h>
+#include <aerospike/as_key.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_record.h>
+
+#include "client.h"
+#include "conversions.h"
+#include "policy.h"
+#include "schema.h"
+
+PyObject * AerospikeSchema_Get(AerospikeSchema * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Arguments
+	PyObject * py_key = NULL;
+	PyObject * py_policy = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"key", "policy", NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "O|O:get", kwlist,
+			&py_key, &py_policy) == false ) {
+		return NULL;
+	}
+
+	// Python Return Value
+	PyObject * py_row = NULL;
+
+	// Aerospike Client Arguments
+	as_error err;
+	as_policy_read policy;
+	as_policy_read * policy_p = NULL;
+	as_key key;
+	bool key_initialized = false;
+	as_record * rec = NULL;
+
+	// Initialize error
+	as_error_init(&err);
+
+	// Convert python key object to as_key
+	AerospikeSchema_Key(self, &err, py_key, &key);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+	key_initialized = true;
+
+	// Convert python policy object to as_policy_read
+	pyobject_to_policy_read(&err, py_policy, &policy, &policy_p);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+
+	// Invoke operation, without holding the GIL while waiting on the network
+	PyThreadState * _save = PyEval_SaveThread();
+	aerospike_key_select(self->client->as, &err, policy_p, &key, self->bins, &rec);
+	PyEval_RestoreThread(_save);
+
+	if ( err.code == AEROSPIKE_OK ) {
+		AerospikeSchema_Row_From_Record(self, &err, rec, &py_row);
+	}
+	else if ( err.code == AEROSPIKE_ERR_RECORD_NOT_FOUND ) {
+		as_error_reset(&err);
+		Py_INCREF(Py_None);
+		py_row = Py_None;
+	}
+
+CLEANUP:
+
+	if ( rec != NULL ) {
+		as_record_destroy(rec);
+	}
+
+	if ( key_initialized ) {
+		as_key_destroy(&key);
+	}
+
+	if ( err.code != AEROSPIKE_OK ) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyErr_SetObject(PyExc_Exception, py_err);
+		return NULL;
+	}
+
+	return py_row;
+}
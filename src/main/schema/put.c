@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include <aerospike/aerospike_key.h>
+#include <aerospike/as_key.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_record.h>
+
+#include "arena.h"
+#include "client.h"
+#include "conversions.h"
+#include "policy.h"
+#include "schema.h"
+
+PyObject * AerospikeSchema_Put(AerospikeSchema * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Arguments
+	PyObject * py_key = NULL;
+	PyObject * py_row = NULL;
+	PyObject * py_meta = NULL;
+	PyObject * py_policy = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"key", "row", "metadata", "policy", NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "OO|OO:put", kwlist,
+			&py_key, &py_row, &py_meta, &py_policy) == false ) {
+		return NULL;
+	}
+
+	// Aerospike Client Arguments
+	as_error err;
+	as_policy_write policy;
+	as_policy_write * policy_p = NULL;
+	as_key key;
+	bool key_initialized = false;
+	as_record rec;
+	bool rec_initialized = false;
+	arena arena;
+	compression compression;
+
+	// Initialize error
+	as_error_init(&err);
+
+	// The values of the record are allocated from the arena
+	arena_init(&arena);
+
+	// Convert python key object to as_key
+	AerospikeSchema_Key(self, &err, py_key, &key);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+	key_initialized = true;
+
+	// Convert python row and metadata objects to as_record
+	AerospikeSchema_Row_To_Record(self, &err, py_row, py_meta, &rec, &arena);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+	rec_initialized = true;
+
+	// Convert python policy object to as_policy_write
+	pyobject_to_policy_write(&err, py_policy, &policy, &policy_p);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+
+	// The policy may override the compression of the client
+	pyobject_to_compression(&err, py_policy, &self->client->compression, &compression);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+
+	// Compress and invoke operation, without holding the GIL
+	PyThreadState * _save = PyEval_SaveThread();
+	if ( compression_compress_record(&err, &compression, &rec, &arena) == AEROSPIKE_OK ) {
+		aerospike_key_put(self->client->as, &err, policy_p, &key, &rec);
+	}
+	PyEval_RestoreThread(_save);
+
+CLEANUP:
+
+	if ( rec_initialized ) {
+		as_record_destroy(&rec);
+	}
+
+	if ( key_initialized ) {
+		as_key_destroy(&key);
+	}
+
+	arena_destroy(&arena);
+
+	if ( err.code != AEROSPIKE_OK ) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyErr_SetObject(PyExc_Exception, py_err);
+		return NULL;
+	}
+
+	return PyLong_FromLong(0);
+}
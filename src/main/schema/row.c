@@ -0,0 +1,155 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <structseq.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <aerospike/as_error.h>
+#include <aerospike/as_record.h>
+
+#include "conversions.h"
+#include "schema.h"
+
+#define ROW_ITEM(__row, __i) (((PyStructSequence *) (__row))->ob_item[__i])
+
+/**
+ * Returns the position of a bin in the schema, or -1 if it is not in the
+ * schema. The bins usually come back in the order they were selected in, so
+ * the position of the bin in the record is tried first.
+ */
+static int schema_field_index(const AerospikeSchema * self, const char * name, uint16_t hint)
+{
+	if ( hint < self->n_fields && strcmp(self->fields[hint].name, name) == 0 ) {
+		return hint;
+	}
+
+	for ( uint16_t i = 0; i < self->n_fields; i++ ) {
+		if ( strcmp(self->fields[i].name, name) == 0 ) {
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+as_status AerospikeSchema_Row_From_Record(AerospikeSchema * self, as_error * err, const as_record * rec, PyObject ** py_row)
+{
+	as_error_reset(err);
+
+	if ( ! rec ) {
+		// this should never happen, but if it did...
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "record is null");
+	}
+
+	PyObject * row = PyStructSequence_New(self->row_type);
+	if ( row == NULL ) {
+		PyErr_Clear();
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "failed to allocate a row");
+	}
+
+	for ( uint16_t i = 0; i < self->n_fields; i++ ) {
+		Py_INCREF(Py_None);
+		PyStructSequence_SET_ITEM(row, i, Py_None);
+	}
+
+	for ( uint16_t b = 0; b < rec->bins.size; b++ ) {
+		const as_bin * bin = &rec->bins.entries[b];
+
+		int i = schema_field_index(self, bin->name, b);
+		if ( i < 0 ) {
+			continue;
+		}
+
+		PyObject * py_val = NULL;
+		val_to_pyobject_owned(self->client, err, (as_val *) bin->valuep, NULL, &py_val);
+		if ( err->code != AEROSPIKE_OK ) {
+			Py_DECREF(row);
+			return err->code;
+		}
+
+		Py_DECREF(ROW_ITEM(row, i));
+		PyStructSequence_SET_ITEM(row, i, py_val);
+	}
+
+	*py_row = row;
+
+	return err->code;
+}
+
+as_status AerospikeSchema_Row_To_Record(AerospikeSchema * self, as_error * err, PyObject * py_row, PyObject * py_meta, as_record * rec, arena * arena)
+{
+	as_error_reset(err);
+
+	if ( ! py_row ) {
+		// this should never happen, but if it did...
+		return as_error_update(err, AEROSPIKE_ERR_CLIENT, "row is null");
+	}
+
+	PyObject * py_seq = PySequence_Fast(py_row, "row must be a sequence");
+	if ( py_seq == NULL ) {
+		PyErr_Clear();
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "row must be a tuple or list");
+	}
+
+	if ( PySequence_Fast_GET_SIZE(py_seq) != self->n_fields ) {
+		Py_DECREF(py_seq);
+		return as_error_update(err, AEROSPIKE_ERR_PARAM, "row must have %d values, one for each bin of the schema", self->n_fields);
+	}
+
+	PyObject ** py_values = PySequence_Fast_ITEMS(py_seq);
+
+	as_record_init(rec, self->n_fields);
+
+	for ( uint16_t i = 0; i < self->n_fields; i++ ) {
+		const schema_field * field = &self->fields[i];
+		PyObject * py_val = py_values[i];
+
+		if ( py_val == Py_None ) {
+			as_record_set_nil(rec, field->name);
+			continue;
+		}
+
+		// Values of the declared type go straight to its converter, and any
+		// other value is converted by its own type
+		as_val * val = NULL;
+		if ( field->convert && Py_TYPE(py_val) == field->type ) {
+			field->convert(self->client, err, py_val, &val, arena);
+		}
+		else {
+			pyobject_to_val(self->client, err, py_val, &val, arena);
+		}
+
+		if ( err->code != AEROSPIKE_OK ) {
+			break;
+		}
+
+		as_record_set(rec, field->name, (as_bin_value *) val);
+	}
+
+	if ( err->code == AEROSPIKE_OK ) {
+		pyobject_to_metadata(err, py_meta, rec);
+	}
+
+	if ( err->code != AEROSPIKE_OK ) {
+		as_record_destroy(rec);
+	}
+
+	Py_DECREF(py_seq);
+
+	return err->code;
+}
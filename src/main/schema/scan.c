@@ -0,0 +1,219 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+
+#include <aerospike/aerospike_scan.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_record.h>
+#include <aerospike/as_scan.h>
+
+#include "client.h"
+#include "conversions.h"
+#include "policy.h"
+#include "schema.h"
+
+// Struct for Python User-Data for the Callback
+typedef struct {
+	as_error error;
+	AerospikeSchema * schema;
+	PyObject * callback;
+	PyObject * py_results;
+	bool done;
+	PyObject * py_exc_type;
+	PyObject * py_exc_value;
+	PyObject * py_exc_traceback;
+} LocalData;
+
+/**
+ * Called by the scan threads for each record. The results are appended to
+ * the list, or passed to the callback, which stops the scan by returning
+ * False or by raising an exception. The exception is kept, to be raised on
+ * the calling thread.
+ */
+static bool each_row(const as_val * val, void * udata)
+{
+	if ( !val ) {
+		return false;
+	}
+
+	LocalData * data = (LocalData *) udata;
+	as_record * rec = as_record_fromval(val);
+
+	if ( !rec ) {
+		return true;
+	}
+
+	PyGILState_STATE gstate;
+	gstate = PyGILState_Ensure();
+
+	// Another scan thread has stopped the scan
+	if ( data->done ) {
+		PyGILState_Release(gstate);
+		return false;
+	}
+
+	PyObject * py_row = NULL;
+	as_error err;
+	AerospikeSchema_Row_From_Record(data->schema, &err, rec, &py_row);
+
+	if ( err.code != AEROSPIKE_OK ) {
+		as_error_copy(&data->error, &err);
+		data->done = true;
+	}
+	else if ( data->callback ) {
+		PyObject * py_ret = PyObject_CallFunctionObjArgs(data->callback, py_row, NULL);
+		if ( py_ret == NULL ) {
+			PyErr_Fetch(&data->py_exc_type, &data->py_exc_value, &data->py_exc_traceback);
+			data->done = true;
+		}
+		else {
+			if ( py_ret == Py_False ) {
+				data->done = true;
+			}
+			Py_DECREF(py_ret);
+		}
+	}
+	else {
+		PyList_Append(data->py_results, py_row);
+	}
+
+	Py_XDECREF(py_row);
+
+	bool more = ! data->done;
+
+	PyGILState_Release(gstate);
+
+	return more;
+}
+
+/**
+ * Scans the bins of the schema in its set.
+ */
+static PyObject * AerospikeSchema_Scan_Invoke(AerospikeSchema * self, PyObject * py_callback, PyObject * py_policy)
+{
+	// Python Return Value
+	PyObject * py_results = NULL;
+
+	// Aerospike Client Arguments
+	as_error err;
+	as_policy_scan policy;
+	as_policy_scan * policy_p = NULL;
+	as_scan scan;
+
+	// Initialize error
+	as_error_init(&err);
+
+	// Convert python policy object to as_policy_scan
+	pyobject_to_policy_scan(&err, py_policy, &policy, &policy_p);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+
+	as_scan_init(&scan, PyString_AsString(self->namespace), PyString_AsString(self->set));
+	as_scan_select_init(&scan, self->n_fields);
+	for ( uint16_t i = 0; i < self->n_fields; i++ ) {
+		as_scan_select(&scan, self->fields[i].name);
+	}
+
+	if ( py_callback == NULL ) {
+		py_results = PyList_New(0);
+	}
+
+	// Create and initialize callback user-data
+	LocalData data = {
+		.schema = self,
+		.callback = py_callback,
+		.py_results = py_results,
+		.done = false,
+		.py_exc_type = NULL,
+		.py_exc_value = NULL,
+		.py_exc_traceback = NULL
+	};
+	as_error_init(&data.error);
+
+	// We are spawning multiple threads
+	PyThreadState * _save = PyEval_SaveThread();
+
+	// Invoke operation
+	aerospike_scan_foreach(self->client->as, &err, policy_p, &scan, each_row, &data);
+
+	// We are done using multiple threads
+	PyEval_RestoreThread(_save);
+
+	as_scan_destroy(&scan);
+
+	if ( data.py_exc_type ) {
+		Py_XDECREF(py_results);
+		PyErr_Restore(data.py_exc_type, data.py_exc_value, data.py_exc_traceback);
+		return NULL;
+	}
+
+	if ( data.error.code != AEROSPIKE_OK ) {
+		as_error_copy(&err, &data.error);
+	}
+
+CLEANUP:
+
+	if ( err.code != AEROSPIKE_OK ) {
+		Py_XDECREF(py_results);
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyErr_SetObject(PyExc_Exception, py_err);
+		return NULL;
+	}
+
+	if ( py_results == NULL ) {
+		Py_INCREF(Py_None);
+		return Py_None;
+	}
+
+	return py_results;
+}
+
+PyObject * AerospikeSchema_Foreach(AerospikeSchema * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Arguments
+	PyObject * py_callback = NULL;
+	PyObject * py_policy = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"callback", "policy", NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "O|O:foreach", kwlist, &py_callback, &py_policy) == false ) {
+		return NULL;
+	}
+
+	return AerospikeSchema_Scan_Invoke(self, py_callback, py_policy);
+}
+
+PyObject * AerospikeSchema_Results(AerospikeSchema * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Arguments
+	PyObject * py_policy = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"policy", NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "|O:results", kwlist, &py_policy) == false ) {
+		return NULL;
+	}
+
+	return AerospikeSchema_Scan_Invoke(self, NULL, py_policy);
+}
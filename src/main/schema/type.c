@@ -0,0 +1,333 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <structmember.h>
+#include <structseq.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <aerospike/aerospike.h>
+#include <aerospike/as_error.h>
+#include <aerospike/as_key.h>
+
+#include "client.h"
+#include "conversions.h"
+#include "schema.h"
+
+/*******************************************************************************
+ * PYTHON TYPE METHODS
+ ******************************************************************************/
+
+static PyMethodDef AerospikeSchema_Type_Methods[] = {
+
+	{"get",		(PyCFunction) AerospikeSchema_Get,		METH_VARARGS | METH_KEYWORDS,
+				"Read the bins of the schema of a record, as a row."},
+
+	{"put",		(PyCFunction) AerospikeSchema_Put,		METH_VARARGS | METH_KEYWORDS,
+				"Write a record from a tuple of values, in the order of the schema."},
+
+	{"foreach",	(PyCFunction) AerospikeSchema_Foreach,	METH_VARARGS | METH_KEYWORDS,
+				"Scan the set, and call the callback function with each row."},
+
+	{"results",	(PyCFunction) AerospikeSchema_Results,	METH_VARARGS | METH_KEYWORDS,
+				"Scan the set, and return a list of the rows."},
+
+	{NULL}
+};
+
+/*******************************************************************************
+ * ROW TYPE
+ ******************************************************************************/
+
+/**
+ * Creates the struct sequence type of the rows, with a field for each bin.
+ * Rows do not hold a reference to their type, so the type, and the names it
+ * points to, are never released. A schema is meant to be created once for a
+ * set, and kept.
+ */
+static PyTypeObject * schema_row_type_new(as_error * err, const schema_field * fields, uint16_t n_fields)
+{
+	PyStructSequence_Field * row_fields = calloc(n_fields + 1, sizeof(PyStructSequence_Field));
+
+	for ( uint16_t i = 0; i < n_fields; i++ ) {
+		row_fields[i].name = strdup(fields[i].name);
+		row_fields[i].doc = NULL;
+	}
+
+	PyStructSequence_Desc desc = {
+		.name = "aerospike.Row",
+		.doc = "A row of the bins of a record, in the order of its schema.",
+		.fields = row_fields,
+		.n_in_sequence = n_fields
+	};
+
+	PyTypeObject * row_type = calloc(1, sizeof(PyTypeObject));
+	PyStructSequence_InitType(row_type, &desc);
+
+	if ( PyErr_Occurred() ) {
+		PyErr_Clear();
+		as_error_update(err, AEROSPIKE_ERR_CLIENT, "failed to create the row type");
+		return NULL;
+	}
+
+	return row_type;
+}
+
+/*******************************************************************************
+ * PYTHON TYPE HOOKS
+ ******************************************************************************/
+
+static PyObject * AerospikeSchema_Type_New(PyTypeObject * type, PyObject * args, PyObject * kwds)
+{
+	AerospikeSchema * self = NULL;
+
+	self = (AerospikeSchema *) type->tp_alloc(type, 0);
+
+	if ( self == NULL ) {
+		return NULL;
+	}
+
+	return (PyObject *) self;
+}
+
+/**
+ * Compiles the list of bins. Each bin is either a name, which accepts values
+ * of any type, or a (name, type) tuple, where the type is one of the types
+ * the client converts: int, long, bool, float, str, bytearray, list, tuple or
+ * dict.
+ */
+static int AerospikeSchema_Type_Init(AerospikeSchema * self, PyObject * args, PyObject * kwds)
+{
+	// Python Function Arguments
+	PyObject * py_namespace = NULL;
+	PyObject * py_set = NULL;
+	PyObject * py_bins = NULL;
+
+	// Python Function Keyword Arguments
+	static char * kwlist[] = {"namespace", "set", "bins", NULL};
+
+	// Python Function Argument Parsing
+	if ( PyArg_ParseTupleAndKeywords(args, kwds, "OOO:schema", kwlist,
+			&py_namespace, &py_set, &py_bins) == false ) {
+		return -1;
+	}
+
+	as_error err;
+	as_error_init(&err);
+
+	PyObject * py_seq = NULL;
+
+	if ( ! PyString_Check(py_namespace) || ! PyString_Check(py_set) ) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "namespace and set must be strings");
+		goto CLEANUP;
+	}
+
+	if ( ! PyList_Check(py_bins) && ! PyTuple_Check(py_bins) ) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "bins must be a list or tuple");
+		goto CLEANUP;
+	}
+
+	py_seq = PySequence_Fast(py_bins, "bins must be a list or tuple");
+	Py_ssize_t n_fields = PySequence_Fast_GET_SIZE(py_seq);
+	PyObject ** py_items = PySequence_Fast_ITEMS(py_seq);
+
+	if ( n_fields == 0 || n_fields > UINT16_MAX ) {
+		as_error_update(&err, AEROSPIKE_ERR_PARAM, "a schema must have between 1 and %d bins", UINT16_MAX);
+		goto CLEANUP;
+	}
+
+	self->fields = calloc(n_fields, sizeof(schema_field));
+	self->bins = calloc(n_fields + 1, sizeof(char *));
+	self->n_fields = (uint16_t) n_fields;
+
+	for ( Py_ssize_t i = 0; i < n_fields; i++ ) {
+		schema_field * field = &self->fields[i];
+		PyObject * py_name = py_items[i];
+		PyObject * py_type = Py_None;
+
+		if ( PyTuple_Check(py_name) && PyTuple_GET_SIZE(py_name) == 2 ) {
+			py_type = PyTuple_GET_ITEM(py_name, 1);
+			py_name = PyTuple_GET_ITEM(py_name, 0);
+		}
+
+		if ( ! PyString_Check(py_name) || PyString_GET_SIZE(py_name) == 0 || PyString_GET_SIZE(py_name) > AS_BIN_NAME_MAX_LEN ) {
+			as_error_update(&err, AEROSPIKE_ERR_PARAM, "a bin must be a name of at most %d characters, or a (name, type) tuple", AS_BIN_NAME_MAX_LEN);
+			goto CLEANUP;
+		}
+
+		const char * name = PyString_AS_STRING(py_name);
+
+		for ( Py_ssize_t j = 0; j < i; j++ ) {
+			if ( strcmp(self->fields[j].name, name) == 0 ) {
+				as_error_update(&err, AEROSPIKE_ERR_PARAM, "bin %s appears more than once", name);
+				goto CLEANUP;
+			}
+		}
+
+		strcpy(field->name, name);
+		self->bins[i] = field->name;
+
+		if ( py_type != Py_None ) {
+			if ( PyType_Check(py_type) ) {
+				field->convert = pyobject_to_val_converter((PyTypeObject *) py_type);
+			}
+			if ( field->convert == NULL ) {
+				as_error_update(&err, AEROSPIKE_ERR_PARAM, "bin %s has a type which is not supported", name);
+				goto CLEANUP;
+			}
+			Py_INCREF(py_type);
+			field->type = (PyTypeObject *) py_type;
+		}
+	}
+
+	self->row_type = schema_row_type_new(&err, self->fields, self->n_fields);
+	if ( err.code != AEROSPIKE_OK ) {
+		goto CLEANUP;
+	}
+
+	Py_INCREF(py_namespace);
+	self->namespace = py_namespace;
+
+	Py_INCREF(py_set);
+	self->set = py_set;
+
+CLEANUP:
+
+	Py_XDECREF(py_seq);
+
+	if ( err.code != AEROSPIKE_OK ) {
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyErr_SetObject(PyExc_Exception, py_err);
+		return -1;
+	}
+
+	return 0;
+}
+
+static void AerospikeSchema_Type_Dealloc(AerospikeSchema * self)
+{
+	if ( self->fields ) {
+		for ( uint16_t i = 0; i < self->n_fields; i++ ) {
+			Py_XDECREF(self->fields[i].type);
+		}
+		free(self->fields);
+	}
+	free(self->bins);
+
+	Py_XDECREF(self->namespace);
+	Py_XDECREF(self->set);
+	Py_XDECREF(self->client);
+
+	self->ob_type->tp_free((PyObject *) self);
+}
+
+/*******************************************************************************
+ * PYTHON TYPE DESCRIPTOR
+ ******************************************************************************/
+
+static PyTypeObject AerospikeSchema_Type = {
+	PyObject_HEAD_INIT(NULL)
+
+	.ob_size			= 0,
+	.tp_name			= "aerospike.Schema",
+	.tp_basicsize		= sizeof(AerospikeSchema),
+	.tp_itemsize		= 0,
+	.tp_dealloc			= (destructor) AerospikeSchema_Type_Dealloc,
+	.tp_print			= 0,
+	.tp_getattr			= 0,
+	.tp_setattr			= 0,
+	.tp_compare			= 0,
+	.tp_repr			= 0,
+	.tp_as_number		= 0,
+	.tp_as_sequence		= 0,
+	.tp_as_mapping		= 0,
+	.tp_hash			= 0,
+	.tp_call			= 0,
+	.tp_str				= 0,
+	.tp_getattro		= 0,
+	.tp_setattro		= 0,
+	.tp_as_buffer		= 0,
+	.tp_flags			= Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+	.tp_doc				=
+			"The Schema class reads and writes the records of a set with a\n"
+			"fixed list of bins. Records are read as rows, with an attribute\n"
+			"for each bin, and written from tuples of values in the order of\n"
+			"the bins. To create a new instance of the Schema class, call the\n"
+			"schema() method on an instance of a Client class.\n",
+	.tp_traverse		= 0,
+	.tp_clear			= 0,
+	.tp_richcompare		= 0,
+	.tp_weaklistoffset	= 0,
+	.tp_iter			= 0,
+	.tp_iternext		= 0,
+	.tp_methods			= AerospikeSchema_Type_Methods,
+	.tp_members			= 0,
+	.tp_getset			= 0,
+	.tp_base			= 0,
+	.tp_dict			= 0,
+	.tp_descr_get		= 0,
+	.tp_descr_set		= 0,
+	.tp_dictoffset		= 0,
+	.tp_init			= 0,
+	.tp_alloc			= 0,
+	.tp_new				= 0
+};
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+PyTypeObject * AerospikeSchema_Ready()
+{
+	return PyType_Ready(&AerospikeSchema_Type) == 0 ? &AerospikeSchema_Type : NULL;
+}
+
+AerospikeSchema * AerospikeSchema_New(AerospikeClient * client, PyObject * args, PyObject * kwds)
+{
+	// A schema requires a client, so it is only created by client.schema()
+	AerospikeSchema * self = (AerospikeSchema *) AerospikeSchema_Type_New(&AerospikeSchema_Type, args, kwds);
+	if ( self == NULL ) {
+		return NULL;
+	}
+
+	self->client = client;
+	Py_INCREF(client);
+
+	if ( AerospikeSchema_Type_Init(self, args, kwds) != 0 ) {
+		Py_DECREF(self);
+		return NULL;
+	}
+
+	return self;
+}
+
+as_status AerospikeSchema_Key(AerospikeSchema * self, as_error * err, PyObject * py_key, as_key * key)
+{
+	if ( PyTuple_Check(py_key) || PyDict_Check(py_key) ) {
+		return pyobject_to_key(err, py_key, key);
+	}
+
+	// The key borrows the value, which the caller holds, and copies the
+	// namespace and set
+	PyObject * py_keytuple = PyTuple_Pack(3, self->namespace, self->set, py_key);
+	pyobject_to_key(err, py_keytuple, key);
+	Py_DECREF(py_keytuple);
+
+	return err->code;
+}
@@ -0,0 +1,171 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <aerospike/as_error.h>
+
+#include "packer.h"
+#include "serializer.h"
+
+/*******************************************************************************
+ * USER SERIALIZER
+ ******************************************************************************/
+
+/**
+ * Reports the pending Python exception of a serializer call as an error.
+ */
+static as_status serializer_error(as_error * err, const char * what)
+{
+	PyObject * py_type = NULL;
+	PyObject * py_value = NULL;
+	PyObject * py_traceback = NULL;
+	PyErr_Fetch(&py_type, &py_value, &py_traceback);
+
+	PyObject * py_str = py_value ? PyObject_Str(py_value) : NULL;
+	as_error_update(err, AEROSPIKE_ERR_CLIENT, "%s failed: %s", what, py_str ? PyString_AsString(py_str) : "unknown error");
+
+	Py_XDECREF(py_str);
+	Py_XDECREF(py_type);
+	Py_XDECREF(py_value);
+	Py_XDECREF(py_traceback);
+	PyErr_Clear();
+
+	return err->code;
+}
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+as_status serializer_init(serializer * s, as_error * err, PyObject * py_config)
+{
+	as_error_reset(err);
+
+	s->type = SERIALIZER_NONE;
+	s->func = NULL;
+
+	if ( py_config == NULL || py_config == Py_None ) {
+		return err->code;
+	}
+
+	if ( PyInt_Check(py_config) && PyInt_AsLong(py_config) == SERIALIZER_MSGPACK ) {
+		s->type = SERIALIZER_MSGPACK;
+	}
+	else if ( PyCallable_Check(py_config) ) {
+		Py_INCREF(py_config);
+		s->type = SERIALIZER_USER;
+		s->func = py_config;
+	}
+	else {
+		as_error_update(err, AEROSPIKE_ERR_PARAM, "serializer and deserializer must be aerospike.SERIALIZER_MSGPACK or callable");
+	}
+
+	return err->code;
+}
+
+void serializer_destroy(serializer * s)
+{
+	Py_XDECREF(s->func);
+	s->func = NULL;
+	s->type = SERIALIZER_NONE;
+}
+
+as_status serializer_dump(const serializer * s, as_error * err, PyObject * py_obj, uint8_t ** data, uint32_t * size)
+{
+	as_error_reset(err);
+
+	if ( s->type == SERIALIZER_MSGPACK ) {
+		pack_buffer b = { NULL, 0, 0 };
+		if ( pack_pyobject(err, &b, py_obj, 0) != AEROSPIKE_OK ) {
+			free(b.data);
+			return err->code;
+		}
+		if ( b.size > UINT32_MAX ) {
+			free(b.data);
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "serialized value exceeds 4 GiB");
+		}
+		*data = b.data;
+		*size = (uint32_t) b.size;
+		return err->code;
+	}
+
+	if ( s->type == SERIALIZER_USER ) {
+		PyObject * py_result = PyObject_CallFunctionObjArgs(s->func, py_obj, NULL);
+		if ( py_result == NULL ) {
+			return serializer_error(err, "serializer");
+		}
+
+		const char * bytes = NULL;
+		Py_ssize_t n = 0;
+		if ( PyString_Check(py_result) ) {
+			bytes = PyString_AS_STRING(py_result);
+			n = PyString_GET_SIZE(py_result);
+		}
+		else if ( PyByteArray_Check(py_result) ) {
+			bytes = PyByteArray_AS_STRING(py_result);
+			n = PyByteArray_GET_SIZE(py_result);
+		}
+		else {
+			Py_DECREF(py_result);
+			return as_error_update(err, AEROSPIKE_ERR_PARAM, "serializer must return a str or bytearray");
+		}
+
+		*data = (uint8_t *) malloc(n ? n : 1);
+		memcpy(*data, bytes, n);
+		*size = (uint32_t) n;
+
+		Py_DECREF(py_result);
+		return err->code;
+	}
+
+	return as_error_update(err, AEROSPIKE_ERR_PARAM, "value of type %s is not a supported type.", Py_TYPE(py_obj)->tp_name);
+}
+
+as_status serializer_load(const serializer * s, as_error * err, const uint8_t * data, uint32_t size, PyObject ** py_obj)
+{
+	as_error_reset(err);
+
+	if ( s->type == SERIALIZER_MSGPACK ) {
+		unpack_reader r = { data, data + size, NULL, NULL };
+		if ( unpack_pyobject(&r, err, py_obj, 0) != AEROSPIKE_OK ) {
+			return err->code;
+		}
+		if ( r.pos != r.end ) {
+			Py_DECREF(*py_obj);
+			*py_obj = NULL;
+			return as_error_update(err, AEROSPIKE_ERR_CLIENT, "serialized value has trailing bytes");
+		}
+		return err->code;
+	}
+
+	if ( s->type == SERIALIZER_USER ) {
+		PyObject * py_bytes = PyString_FromStringAndSize((const char *) data, size);
+		*py_obj = PyObject_CallFunctionObjArgs(s->func, py_bytes, NULL);
+		Py_DECREF(py_bytes);
+		if ( *py_obj == NULL ) {
+			return serializer_error(err, "deserializer");
+		}
+		return err->code;
+	}
+
+	*py_obj = PyByteArray_FromStringAndSize((const char *) data, size);
+	return err->code;
+}
@@ -0,0 +1,290 @@
+/*******************************************************************************
+ * Copyright 2013-2014 Aerospike, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************/
+
+#include <Python.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <aerospike/aerospike_query.h>
+#include <aerospike/aerospike_scan.h>
+#include <aerospike/as_error.h>
+
+#include "cancel.h"
+#include "client.h"
+#include "conversions.h"
+#include "results.h"
+#include "stream.h"
+
+/*******************************************************************************
+ * NATIVE THREAD
+ ******************************************************************************/
+
+static bool each_result(const as_val * val, void * udata)
+{
+	if ( !val ) {
+		return false;
+	}
+
+	return results_queue_add((results_queue *) udata, val);
+}
+
+/**
+ * Runs the scan or query, without the GIL.
+ */
+static void * AerospikeStream_Run(void * udata)
+{
+	AerospikeStream * self = (AerospikeStream *) udata;
+
+	as_error err;
+	as_error_init(&err);
+
+	if ( self->scan ) {
+		aerospike_scan_foreach(self->client->as, &err, self->scan_policy_p, self->scan, each_result, &self->queue);
+	}
+	else {
+		aerospike_query_foreach(self->client->as, &err, self->query_policy_p, self->query, each_result, &self->queue);
+	}
+
+	results_queue_done(&self->queue, &err);
+
+	return NULL;
+}
+
+/**
+ * Waits for the native thread to finish. Requires the GIL, which is released
+ * while waiting.
+ */
+static void AerospikeStream_Join(AerospikeStream * self)
+{
+	if ( self->running ) {
+		Py_BEGIN_ALLOW_THREADS
+		pthread_join(self->thread, NULL);
+		Py_END_ALLOW_THREADS
+		self->running = false;
+	}
+}
+
+/*******************************************************************************
+ * PYTHON TYPE HOOKS
+ ******************************************************************************/
+
+/**
+ * Stops the scan or query, and discards the results not yet yielded.
+ */
+static void AerospikeStream_Close(AerospikeStream * self)
+{
+	if ( self->running ) {
+		results_queue_stop(&self->queue);
+		AerospikeStream_Join(self);
+	}
+
+	results_chunk_destroy(self->chunk);
+	self->chunk = NULL;
+}
+
+/*******************************************************************************
+ * PYTHON TYPE HOOKS
+ ******************************************************************************/
+
+static PyObject * AerospikeStream_Type_IterNext(AerospikeStream * self)
+{
+	as_error err;
+	as_error_init(&err);
+
+	PyObject * py_result = NULL;
+
+	while ( py_result == NULL && err.code == AEROSPIKE_OK ) {
+		if ( self->chunk ) {
+			results_chunk_next(self->chunk, self->client, &err, &py_result);
+			if ( py_result == NULL && err.code == AEROSPIKE_OK ) {
+				results_chunk_destroy(self->chunk);
+				self->chunk = NULL;
+			}
+			continue;
+		}
+
+		if ( ! self->running ) {
+			// All results were yielded
+			return NULL;
+		}
+
+		bool done = false;
+
+		Py_BEGIN_ALLOW_THREADS
+		self->chunk = results_queue_take(&self->queue, RESULTS_WAIT_MS, &done, &err);
+		Py_END_ALLOW_THREADS
+
+		if ( done ) {
+			AerospikeStream_Join(self);
+		}
+		else if ( self->chunk == NULL ) {
+			// Stop on the exception of a signal handler, or a cancelled token
+			if ( PyErr_CheckSignals() != 0 ) {
+				AerospikeStream_Close(self);
+				return NULL;
+			}
+			if ( AerospikeCancelToken_Cancelled(self->cancel) ) {
+				AerospikeStream_Close(self);
+				return NULL;
+			}
+		}
+	}
+
+	if ( err.code != AEROSPIKE_OK ) {
+		AerospikeStream_Close(self);
+
+		PyObject * py_err = NULL;
+		error_to_pyobject(&err, &py_err);
+		PyErr_SetObject(PyExc_Exception, py_err);
+		return NULL;
+	}
+
+	return py_result;
+}
+
+static void AerospikeStream_Type_Dealloc(AerospikeStream * self)
+{
+	AerospikeStream_Close(self);
+	results_queue_destroy(&self->queue);
+
+	Py_XDECREF(self->cancel);
+	Py_XDECREF(self->source);
+	Py_XDECREF(self->client);
+	self->ob_type->tp_free((PyObject *) self);
+}
+
+/*******************************************************************************
+ * PYTHON TYPE DESCRIPTOR
+ ******************************************************************************/
+
+static PyTypeObject AerospikeStream_Type = {
+	PyObject_HEAD_INIT(NULL)
+
+    .ob_size			= 0,
+    .tp_name			= "aerospike.ResultStream",
+    .tp_basicsize		= sizeof(AerospikeStream),
+    .tp_itemsize		= 0,
+    .tp_dealloc			= (destructor) AerospikeStream_Type_Dealloc,
+    .tp_print			= 0,
+    .tp_getattr			= 0,
+    .tp_setattr			= 0,
+    .tp_compare			= 0,
+    .tp_repr			= 0,
+    .tp_as_number		= 0,
+    .tp_as_sequence		= 0,
+    .tp_as_mapping		= 0,
+    .tp_hash			= 0,
+    .tp_call			= 0,
+    .tp_str				= 0,
+    .tp_getattro		= 0,
+    .tp_setattro		= 0,
+    .tp_as_buffer		= 0,
+    .tp_flags			= Py_TPFLAGS_DEFAULT,
+    .tp_doc				= 
+    		"An iterator over the results of a scan or query, returned by the\n"
+    		"results() method of a Scan or Query. Results are yielded as they\n"
+    		"arrive from the cluster. The scan or query pauses while results\n"
+    		"are not consumed, and stops once the iterator is released, once\n"
+    		"its limit is reached, or once its cancel token is cancelled.\n",
+    .tp_traverse		= 0,
+    .tp_clear			= 0,
+    .tp_richcompare		= 0,
+    .tp_weaklistoffset	= 0,
+    .tp_iter			= PyObject_SelfIter,
+    .tp_iternext		= (iternextfunc) AerospikeStream_Type_IterNext,
+    .tp_methods			= 0,
+    .tp_members			= 0,
+    .tp_getset			= 0,
+    .tp_base			= 0,
+    .tp_dict			= 0,
+    .tp_descr_get		= 0,
+    .tp_descr_set		= 0,
+    .tp_dictoffset		= 0,
+    .tp_init			= 0,
+    .tp_alloc			= 0,
+    .tp_new				= 0
+};
+
+/*******************************************************************************
+ * PUBLIC FUNCTIONS
+ ******************************************************************************/
+
+PyTypeObject * AerospikeStream_Ready()
+{
+	return PyType_Ready(&AerospikeStream_Type) == 0 ? &AerospikeStream_Type : NULL;
+}
+
+/**
+ * Creates the stream, and starts the native thread, which was given the scan
+ * or query to run.
+ */
+static AerospikeStream * AerospikeStream_Start(AerospikeStream * self, AerospikeClient * client, PyObject * source, uint32_t limit, AerospikeCancelToken * cancel)
+{
+	self->client = client;
+	Py_INCREF(client);
+	self->source = source;
+	Py_INCREF(source);
+	self->cancel = cancel;
+	Py_XINCREF(cancel);
+
+	results_queue_init(&self->queue, client);
+	self->queue.limit = limit;
+	self->queue.cancel = cancel;
+	self->chunk = NULL;
+	self->running = false;
+
+	if ( pthread_create(&self->thread, NULL, AerospikeStream_Run, self) != 0 ) {
+		Py_DECREF(self);
+		PyErr_SetString(PyExc_RuntimeError, "failed to start the thread of the results");
+		return NULL;
+	}
+	self->running = true;
+
+	return self;
+}
+
+AerospikeStream * AerospikeStream_Scan(AerospikeScan * scan, const as_policy_scan * policy, uint32_t limit, AerospikeCancelToken * cancel)
+{
+	AerospikeStream * self = (AerospikeStream *) PyType_GenericAlloc(&AerospikeStream_Type, 0);
+	if ( self == NULL ) {
+		return NULL;
+	}
+
+	self->scan = &scan->scan;
+	if ( policy ) {
+		self->scan_policy = *policy;
+		self->scan_policy_p = &self->scan_policy;
+	}
+
+	return AerospikeStream_Start(self, scan->client, (PyObject *) scan, limit, cancel);
+}
+
+AerospikeStream * AerospikeStream_Query(AerospikeQuery * query, const as_policy_query * policy, uint32_t limit, AerospikeCancelToken * cancel)
+{
+	AerospikeStream * self = (AerospikeStream *) PyType_GenericAlloc(&AerospikeStream_Type, 0);
+	if ( self == NULL ) {
+		return NULL;
+	}
+
+	self->query = &query->query;
+	if ( policy ) {
+		self->query_policy = *policy;
+		self->query_policy_p = &self->query_policy;
+	}
+
+	return AerospikeStream_Start(self, query->client, (PyObject *) query, limit, cancel);
+}